@@ -1,8 +1,13 @@
 #include <benchmark/benchmark.h>
 
+#include <cslibs_math/approx/trigonometric.hpp>
 #include <cslibs_math/random/random.hpp>
 #include <cslibs_math/utility/tiny_time.hpp>
 #include <cslibs_math/common/angle.hpp>
+#include <cslibs_math/common/fast_angle.hpp>
+#include <cslibs_math/statistics/angular_mean.hpp>
+#include <cslibs_math/statistics/weighted_angular_mean.hpp>
+#include <vector>
 
 static void normalize_std_atan2(benchmark::State& state) {
   const auto normalize = [](const double x) {
@@ -80,9 +85,224 @@ static void normalize_cslibs_math(benchmark::State& state) {
   }
 }
 
+/// headings of a particle set
+const std::size_t ANGLES = 10000;
+
+template <typename T>
+std::vector<T> angles() {
+  cslibs_math::random::Uniform<T, 1> rng(-M_PI, M_PI, 42);
+  std::vector<T> a(ANGLES);
+  for (auto& v : a) v = rng.get();
+  return a;
+}
+
+template <typename T>
+static void angular_mean_add(benchmark::State& state) {
+  const auto a = angles<T>();
+  for (auto _ : state) {
+    cslibs_math::statistics::AngularMean<T> mean;
+    for (const T v : a) mean.add(v);
+    benchmark::DoNotOptimize(mean.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void angular_mean_add_range(benchmark::State& state) {
+  const auto a = angles<T>();
+  for (auto _ : state) {
+    cslibs_math::statistics::AngularMean<T> mean;
+    mean.add(a.begin(), a.end());
+    benchmark::DoNotOptimize(mean.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void weighted_angular_mean_add(benchmark::State& state) {
+  const auto a = angles<T>();
+  const auto w = angles<T>();
+  for (auto _ : state) {
+    cslibs_math::statistics::WeightedAngularMean<T> mean;
+    for (std::size_t i = 0; i < ANGLES; ++i) mean.add(a[i], w[i] + T(4));
+    benchmark::DoNotOptimize(mean.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void weighted_angular_mean_add_batch(benchmark::State& state) {
+  using mean_t = cslibs_math::statistics::WeightedAngularMean<T>;
+  const auto v = angles<T>();
+  const typename mean_t::angles_t a =
+      Eigen::Map<const typename mean_t::angles_t>(v.data(), ANGLES);
+  const typename mean_t::weights_t w = a.array() + T(4);
+  for (auto _ : state) {
+    mean_t mean;
+    mean.add(a, w);
+    benchmark::DoNotOptimize(mean.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void sincos_std(benchmark::State& state) {
+  const auto a = angles<T>();
+  std::vector<T> sin(ANGLES);
+  std::vector<T> cos(ANGLES);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < ANGLES; ++i) {
+      sin[i] = std::sin(a[i]);
+      cos[i] = std::cos(a[i]);
+    }
+    benchmark::DoNotOptimize(sin.data());
+    benchmark::DoNotOptimize(cos.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void sincos_approx(benchmark::State& state) {
+  const auto a = angles<T>();
+  std::vector<T> sin(ANGLES);
+  std::vector<T> cos(ANGLES);
+  for (auto _ : state) {
+    cslibs_math::approx::sincos(a.data(), sin.data(), cos.data(), ANGLES);
+    benchmark::DoNotOptimize(sin.data());
+    benchmark::DoNotOptimize(cos.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void atan2_std(benchmark::State& state) {
+  const auto y = angles<T>();
+  const auto x = angles<T>();
+  std::vector<T> out(ANGLES);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < ANGLES; ++i) out[i] = std::atan2(y[i], x[i]);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void atan2_approx(benchmark::State& state) {
+  const auto y = angles<T>();
+  const auto x = angles<T>();
+  std::vector<T> out(ANGLES);
+  for (auto _ : state) {
+    cslibs_math::approx::atan2(y.data(), x.data(), out.data(), ANGLES);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void hypot_std(benchmark::State& state) {
+  const auto y = angles<T>();
+  const auto x = angles<T>();
+  std::vector<T> out(ANGLES);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < ANGLES; ++i) out[i] = std::hypot(x[i], y[i]);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void hypot_approx(benchmark::State& state) {
+  const auto y = angles<T>();
+  const auto x = angles<T>();
+  std::vector<T> out(ANGLES);
+  for (auto _ : state) {
+    cslibs_math::approx::hypot(x.data(), y.data(), out.data(), ANGLES);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void difference_cslibs_math(benchmark::State& state) {
+  const auto a = angles<T>();
+  const auto b = angles<T>();
+  std::vector<T> out(ANGLES);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < ANGLES; ++i)
+      out[i] = cslibs_math::common::angle::difference(a[i] * T(10), b[i]);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void difference_fast(benchmark::State& state) {
+  const auto a = angles<T>();
+  const auto b = angles<T>();
+  std::vector<T> out(ANGLES);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < ANGLES; ++i)
+      out[i] = cslibs_math::common::angle::fast::difference(a[i] * T(10), b[i]);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void normalize_range(benchmark::State& state) {
+  const auto a = angles<T>();
+  std::vector<T> out(ANGLES);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < ANGLES; ++i)
+      out[i] = cslibs_math::common::angle::normalize(a[i] * T(10));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
+template <typename T>
+static void normalize_range_fast(benchmark::State& state) {
+  const auto a = angles<T>();
+  std::vector<T> out(ANGLES);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < ANGLES; ++i)
+      out[i] = cslibs_math::common::angle::fast::normalize(a[i] * T(10));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ANGLES);
+}
+
 BENCHMARK(normalize_std_atan2);
 BENCHMARK(normalize_atan2);
 BENCHMARK(normalize_while);
 BENCHMARK(normalize_cslibs_math);
+BENCHMARK_TEMPLATE(angular_mean_add, float);
+BENCHMARK_TEMPLATE(angular_mean_add_range, float);
+BENCHMARK_TEMPLATE(angular_mean_add, double);
+BENCHMARK_TEMPLATE(angular_mean_add_range, double);
+BENCHMARK_TEMPLATE(weighted_angular_mean_add, float);
+BENCHMARK_TEMPLATE(weighted_angular_mean_add_batch, float);
+BENCHMARK_TEMPLATE(weighted_angular_mean_add, double);
+BENCHMARK_TEMPLATE(weighted_angular_mean_add_batch, double);
+BENCHMARK_TEMPLATE(sincos_std, float);
+BENCHMARK_TEMPLATE(sincos_approx, float);
+BENCHMARK_TEMPLATE(atan2_std, float);
+BENCHMARK_TEMPLATE(atan2_approx, float);
+BENCHMARK_TEMPLATE(hypot_std, float);
+BENCHMARK_TEMPLATE(hypot_approx, float);
+BENCHMARK_TEMPLATE(normalize_range, float);
+BENCHMARK_TEMPLATE(normalize_range_fast, float);
+BENCHMARK_TEMPLATE(difference_cslibs_math, float);
+BENCHMARK_TEMPLATE(difference_fast, float);
+BENCHMARK_TEMPLATE(sincos_std, double);
+BENCHMARK_TEMPLATE(sincos_approx, double);
+BENCHMARK_TEMPLATE(atan2_std, double);
+BENCHMARK_TEMPLATE(atan2_approx, double);
+BENCHMARK_TEMPLATE(hypot_std, double);
+BENCHMARK_TEMPLATE(hypot_approx, double);
+BENCHMARK_TEMPLATE(normalize_range, double);
+BENCHMARK_TEMPLATE(normalize_range_fast, double);
+BENCHMARK_TEMPLATE(difference_cslibs_math, double);
+BENCHMARK_TEMPLATE(difference_fast, double);
 
 BENCHMARK_MAIN();
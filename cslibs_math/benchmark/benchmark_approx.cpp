@@ -0,0 +1,392 @@
+#include <benchmark/benchmark.h>
+
+#include <cslibs_math/approx/exp.hpp>
+#include <cslibs_math/approx/fractional.hpp>
+#include <cslibs_math/approx/log.hpp>
+#include <cslibs_math/approx/sqrt.hpp>
+#include <cslibs_math/approx/trigonometric.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+/**
+ * Accuracy and throughput matrix of the approx:: functions against their
+ * std:: counterparts. Every iteration evaluates a whole array, so the timer
+ * is read once per array instead of around every single call. Each
+ * benchmark reports the counters
+ *   time_per_element - seconds per element
+ *   max_ulp_error    - in units in the last place of T
+ *   max_rel_error    - relative error
+ *   max_abs_error    - absolute error
+ * against a long double reference. Use --benchmark_format=json or
+ * --benchmark_out=<file> to collect them for choosing accuracy tiers, and
+ * --benchmark_filter to select functions, types or sizes.
+ */
+
+using cslibs_math::approx::ExpAccuracy;
+
+/// 1K to 16M elements, from L1 sized arrays to main memory
+static void arraySizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(16)->Range(1 << 10, 1 << 24);
+}
+
+template <typename T>
+std::vector<T> uniformInput(const std::size_t n, const double min,
+                            const double max, const unsigned int seed = 42) {
+  cslibs_math::random::Uniform<double, 1> rng(min, max, seed);
+  std::vector<T> in(n);
+  for (T& v : in) v = static_cast<T>(rng.get());
+  return in;
+}
+
+/// maximum errors of results of type T against long double references
+template <typename T>
+class Errors {
+ public:
+  inline void add(const T result, const long double reference) {
+    const long double error = std::abs(result - reference);
+    /// the ulp of the reference rounded to T, denormals share the smallest
+    const int exponent =
+        std::max(std::ilogb(static_cast<T>(reference)),
+                 std::numeric_limits<T>::min_exponent - 1);
+    const long double ulp =
+        std::ldexp(1.0L, exponent - std::numeric_limits<T>::digits + 1);
+    ulp_ = std::max(ulp_, error / ulp);
+    abs_ = std::max(abs_, error);
+    if (reference != 0.0L) rel_ = std::max(rel_, error / std::abs(reference));
+  }
+
+  inline void report(benchmark::State& state, const std::size_t n) const {
+    state.SetItemsProcessed(state.iterations() * n);
+    state.counters["time_per_element"] = benchmark::Counter(
+        static_cast<double>(n), benchmark::Counter::kIsIterationInvariantRate |
+                                    benchmark::Counter::kInvert);
+    state.counters["max_ulp_error"] = static_cast<double>(ulp_);
+    state.counters["max_rel_error"] = static_cast<double>(rel_);
+    state.counters["max_abs_error"] = static_cast<double>(abs_);
+  }
+
+ private:
+  long double ulp_{0};
+  long double rel_{0};
+  long double abs_{0};
+};
+
+/// inputs and references, the kernels below add the bulk evaluation
+struct ExpFunction {
+  template <typename T>
+  static std::vector<T> input(const std::size_t n) {
+    return uniformInput<T>(n, -80.0, 0.0);
+  }
+  static long double reference(const long double x) { return std::exp(x); }
+};
+
+struct LogFunction {
+  template <typename T>
+  static std::vector<T> input(const std::size_t n) {
+    std::vector<T> in = uniformInput<T>(n, -80.0, 80.0);
+    for (T& v : in) v = static_cast<T>(std::exp(static_cast<double>(v)));
+    return in;
+  }
+  static long double reference(const long double x) { return std::log(x); }
+};
+
+struct SqrtFunction {
+  template <typename T>
+  static std::vector<T> input(const std::size_t n) {
+    return uniformInput<T>(n, 0.0, 1e4);
+  }
+  static long double reference(const long double x) { return std::sqrt(x); }
+};
+
+struct Atan2Function {
+  static constexpr double min = -100.0;
+  static constexpr double max = 100.0;
+  static long double reference(const long double y, const long double x) {
+    return std::atan2(y, x);
+  }
+};
+
+struct HypotFunction {
+  static constexpr double min = -100.0;
+  static constexpr double max = 100.0;
+  static long double reference(const long double x, const long double y) {
+    return std::hypot(x, y);
+  }
+};
+
+struct StdExp : ExpFunction {
+  template <typename T>
+  static void eval(const T* in, T* out, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = std::exp(in[i]);
+  }
+};
+
+template <ExpAccuracy Accuracy>
+struct ApproxExp : ExpFunction {
+  template <typename T>
+  static void eval(const T* in, T* out, const std::size_t n) {
+    cslibs_math::approx::exp<Accuracy>(in, out, n);
+  }
+};
+
+struct StdLog : LogFunction {
+  template <typename T>
+  static void eval(const T* in, T* out, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = std::log(in[i]);
+  }
+};
+
+template <ExpAccuracy Accuracy>
+struct ApproxLog : LogFunction {
+  template <typename T>
+  static void eval(const T* in, T* out, const std::size_t n) {
+    using fast_log_t = cslibs_math::approx::detail::FastLog<T, Accuracy>;
+    for (std::size_t i = 0; i < n; ++i) out[i] = fast_log_t::eval(in[i]);
+  }
+};
+
+struct StdSqrt : SqrtFunction {
+  template <typename T>
+  static void eval(const T* in, T* out, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = std::sqrt(in[i]);
+  }
+};
+
+struct ApproxSqrt : SqrtFunction {
+  template <typename T>
+  static void eval(const T* in, T* out, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = cslibs_math::approx::sqrt(in[i]);
+  }
+};
+
+struct StdAtan2 : Atan2Function {
+  template <typename T>
+  static void eval(const T* y, const T* x, T* out, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = std::atan2(y[i], x[i]);
+  }
+};
+
+struct ApproxAtan2 : Atan2Function {
+  template <typename T>
+  static void eval(const T* y, const T* x, T* out, const std::size_t n) {
+    cslibs_math::approx::atan2(y, x, out, n);
+  }
+};
+
+struct StdHypot : HypotFunction {
+  template <typename T>
+  static void eval(const T* x, const T* y, T* out, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = std::hypot(x[i], y[i]);
+  }
+};
+
+struct ApproxHypot : HypotFunction {
+  template <typename T>
+  static void eval(const T* x, const T* y, T* out, const std::size_t n) {
+    cslibs_math::approx::hypot(x, y, out, n);
+  }
+};
+
+template <typename T, typename Kernel>
+static void unary(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> in = Kernel::template input<T>(n);
+  std::vector<T> out(n);
+  for (auto _ : state) {
+    Kernel::eval(in.data(), out.data(), n);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  Errors<T> errors;
+  for (std::size_t i = 0; i < n; ++i)
+    errors.add(out[i], Kernel::reference(in[i]));
+  errors.report(state, n);
+}
+
+template <typename T, typename Kernel>
+static void binary(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> a = uniformInput<T>(n, Kernel::min, Kernel::max, 42);
+  const std::vector<T> b = uniformInput<T>(n, Kernel::min, Kernel::max, 43);
+  std::vector<T> out(n);
+  for (auto _ : state) {
+    Kernel::eval(a.data(), b.data(), out.data(), n);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+
+  Errors<T> errors;
+  for (std::size_t i = 0; i < n; ++i)
+    errors.add(out[i], Kernel::reference(a[i], b[i]));
+  errors.report(state, n);
+}
+
+/// sin and cos of the same angles, the errors are the maxima of both
+struct StdSinCos {
+  template <typename T>
+  static void eval(const T* in, T* sin, T* cos, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      sin[i] = std::sin(in[i]);
+      cos[i] = std::cos(in[i]);
+    }
+  }
+};
+
+struct ApproxSinCos {
+  template <typename T>
+  static void eval(const T* in, T* sin, T* cos, const std::size_t n) {
+    cslibs_math::approx::sincos(in, sin, cos, n);
+  }
+};
+
+template <typename T, typename Kernel>
+static void sincos(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> in = uniformInput<T>(n, -100.0, 100.0);
+  std::vector<T> sin(n);
+  std::vector<T> cos(n);
+  for (auto _ : state) {
+    Kernel::eval(in.data(), sin.data(), cos.data(), n);
+    benchmark::DoNotOptimize(sin.data());
+    benchmark::DoNotOptimize(cos.data());
+    benchmark::ClobberMemory();
+  }
+
+  Errors<T> errors;
+  for (std::size_t i = 0; i < n; ++i) {
+    errors.add(sin[i], std::sin(static_cast<long double>(in[i])));
+    errors.add(cos[i], std::cos(static_cast<long double>(in[i])));
+  }
+  errors.report(state, n);
+}
+
+/**
+ * Products of many likelihoods, which underflow T. All kernels return the
+ * natural logarithm of the product, the errors are the ones of that
+ * logarithm against the long double sum of the logarithms.
+ */
+struct ChainedFractional {
+  template <typename T>
+  static T eval(const T* factors, const std::size_t n) {
+    using fractional_t = cslibs_math::approx::Fractional<T>;
+    fractional_t product(T(1));
+    for (std::size_t i = 0; i < n; ++i)
+      product = product * fractional_t(factors[i]);
+    return std::log(product.fraction()) +
+           static_cast<T>(product.exponent()) * static_cast<T>(M_LN2);
+  }
+};
+
+struct FractionalProduct {
+  template <typename T>
+  static T eval(const T* factors, const std::size_t n) {
+    cslibs_math::approx::FractionalProduct<T> product;
+    product.multiply(factors, n);
+    return product.log();
+  }
+};
+
+template <typename Base>
+struct LogProduct {
+  template <typename T>
+  static T eval(const T* factors, const std::size_t n) {
+    using log_t = cslibs_math::approx::Log<T, typename Base::template type<T>>;
+    log_t product(T(1));
+    for (std::size_t i = 0; i < n; ++i) product *= log_t(factors[i]);
+    return product.value();
+  }
+};
+
+struct StdBaseE {
+  template <typename T>
+  using type = cslibs_math::approx::detail::BaseE<T>;
+};
+
+template <ExpAccuracy Accuracy>
+struct FastBaseE {
+  template <typename T>
+  using type = cslibs_math::approx::detail::FastBaseE<T, Accuracy>;
+};
+
+template <typename T, typename Kernel>
+static void product(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> factors = uniformInput<T>(n, 1e-3, 1.0);
+  T log_product = T();
+  for (auto _ : state) {
+    log_product = Kernel::eval(factors.data(), n);
+    benchmark::DoNotOptimize(log_product);
+  }
+
+  long double reference = 0.0L;
+  for (const T f : factors) reference += std::log(static_cast<long double>(f));
+  Errors<T> errors;
+  errors.add(log_product, reference);
+  errors.report(state, n);
+}
+
+BENCHMARK_TEMPLATE(unary, float, StdExp)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, float, ApproxExp<ExpAccuracy::Coarse>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, float, ApproxExp<ExpAccuracy::Fine>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, float, ApproxExp<ExpAccuracy::Full>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, StdExp)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, ApproxExp<ExpAccuracy::Coarse>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, ApproxExp<ExpAccuracy::Fine>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, ApproxExp<ExpAccuracy::Full>)
+    ->Apply(arraySizes);
+
+BENCHMARK_TEMPLATE(unary, float, StdLog)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, float, ApproxLog<ExpAccuracy::Coarse>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, float, ApproxLog<ExpAccuracy::Fine>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, StdLog)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, ApproxLog<ExpAccuracy::Coarse>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, ApproxLog<ExpAccuracy::Fine>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, ApproxLog<ExpAccuracy::Full>)
+    ->Apply(arraySizes);
+
+BENCHMARK_TEMPLATE(unary, float, StdSqrt)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, float, ApproxSqrt)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, StdSqrt)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(unary, double, ApproxSqrt)->Apply(arraySizes);
+
+BENCHMARK_TEMPLATE(sincos, float, StdSinCos)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(sincos, float, ApproxSinCos)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(sincos, double, StdSinCos)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(sincos, double, ApproxSinCos)->Apply(arraySizes);
+
+BENCHMARK_TEMPLATE(binary, float, StdAtan2)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(binary, float, ApproxAtan2)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(binary, double, StdAtan2)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(binary, double, ApproxAtan2)->Apply(arraySizes);
+
+BENCHMARK_TEMPLATE(binary, float, StdHypot)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(binary, float, ApproxHypot)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(binary, double, StdHypot)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(binary, double, ApproxHypot)->Apply(arraySizes);
+
+BENCHMARK_TEMPLATE(product, float, ChainedFractional)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(product, float, FractionalProduct)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(product, float, LogProduct<StdBaseE>)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(product, float, LogProduct<FastBaseE<ExpAccuracy::Fine>>)
+    ->Apply(arraySizes);
+BENCHMARK_TEMPLATE(product, double, ChainedFractional)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(product, double, FractionalProduct)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(product, double, LogProduct<StdBaseE>)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(product, double, LogProduct<FastBaseE<ExpAccuracy::Fine>>)
+    ->Apply(arraySizes);
+
+BENCHMARK_MAIN();
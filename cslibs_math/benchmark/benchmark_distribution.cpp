@@ -0,0 +1,404 @@
+#include <benchmark/benchmark.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/bhattacharyya.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <cslibs_math/statistics/gaussian_mixture.hpp>
+#include <cslibs_math/statistics/histogram.hpp>
+#include <cslibs_math/statistics/parallel_accumulate.hpp>
+#include <cslibs_math/statistics/stable_weighted_distribution.hpp>
+#include <cslibs_math/statistics/weighted_distribution.hpp>
+#include <vector>
+
+/// each iteration accumulates the same set of random samples
+const std::size_t SAMPLES = 100000;
+
+template <typename T, std::size_t Dim>
+using sample_t = Eigen::Matrix<T, Dim, 1>;
+
+template <typename T, std::size_t Dim>
+using samples_t =
+    std::vector<sample_t<T, Dim>, Eigen::aligned_allocator<sample_t<T, Dim>>>;
+
+template <typename T, std::size_t Dim>
+samples_t<T, Dim> samples() {
+  cslibs_math::random::Uniform<T, Dim> rng(sample_t<T, Dim>::Constant(-10.0),
+                                           sample_t<T, Dim>::Constant(10.0),
+                                           42);
+  samples_t<T, Dim> s(SAMPLES);
+  for (auto &p : s) p = rng.get();
+  return s;
+}
+
+template <typename T, std::size_t Dim>
+Eigen::Matrix<T, Dim, Eigen::Dynamic> matrix(const samples_t<T, Dim> &s) {
+  Eigen::Matrix<T, Dim, Eigen::Dynamic> m(Dim, s.size());
+  for (std::size_t i = 0; i < s.size(); ++i) m.col(i) = s[i];
+  return m;
+}
+
+template <typename T>
+std::vector<T> weights() {
+  cslibs_math::random::Uniform<T, 1> rng(0.0, 1.0, 42);
+  std::vector<T> w(SAMPLES);
+  for (auto &v : w) v = rng.get();
+  return w;
+}
+
+template <typename T, std::size_t Dim>
+static void distribution_add(benchmark::State &state) {
+  const auto s = samples<T, Dim>();
+  for (auto _ : state) {
+    cslibs_math::statistics::Distribution<T, Dim> d;
+    for (const auto &p : s) d.add(p);
+    benchmark::DoNotOptimize(d.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim>
+static void distribution_add_range(benchmark::State &state) {
+  const auto s = samples<T, Dim>();
+  for (auto _ : state) {
+    cslibs_math::statistics::Distribution<T, Dim> d;
+    d.add(s.begin(), s.end());
+    benchmark::DoNotOptimize(d.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim>
+static void distribution_add_matrix(benchmark::State &state) {
+  const auto m = matrix<T, Dim>(samples<T, Dim>());
+  for (auto _ : state) {
+    cslibs_math::statistics::Distribution<T, Dim> d;
+    d.add(m);
+    benchmark::DoNotOptimize(d.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim, template <typename, std::size_t> class D>
+static void weighted_add(benchmark::State &state) {
+  const auto s = samples<T, Dim>();
+  const auto w = weights<T>();
+  for (auto _ : state) {
+    D<T, Dim> d;
+    for (std::size_t i = 0; i < SAMPLES; ++i) d.add(s[i], w[i]);
+    benchmark::DoNotOptimize(d.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim, template <typename, std::size_t> class D>
+static void weighted_add_range(benchmark::State &state) {
+  const auto s = samples<T, Dim>();
+  const auto w = weights<T>();
+  for (auto _ : state) {
+    D<T, Dim> d;
+    d.add(s.begin(), s.end(), w.begin());
+    benchmark::DoNotOptimize(d.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim, template <typename, std::size_t> class D>
+static void weighted_add_matrix(benchmark::State &state) {
+  const auto m = matrix<T, Dim>(samples<T, Dim>());
+  const auto w = weights<T>();
+  const Eigen::Matrix<T, Eigen::Dynamic, 1> v =
+      Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(w.data(),
+                                                             w.size());
+  for (auto _ : state) {
+    D<T, Dim> d;
+    d.add(m, v);
+    benchmark::DoNotOptimize(d.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim>
+static void distribution_parallel_accumulate(benchmark::State &state) {
+  using distribution_t = cslibs_math::statistics::Distribution<T, Dim>;
+  const auto s = samples<T, Dim>();
+  const std::size_t threads = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    const distribution_t d =
+        cslibs_math::statistics::parallelAccumulate<distribution_t>(s,
+                                                                    threads);
+    benchmark::DoNotOptimize(d.getMean());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+/// one EM iteration of 50 components, E-step and M-step
+template <typename T, std::size_t Dim>
+static void gaussian_mixture_iteration(benchmark::State &state) {
+  using mixture_t = cslibs_math::statistics::GaussianMixture<T, Dim>;
+  const typename mixture_t::samples_t s = matrix<T, Dim>(samples<T, Dim>());
+  const std::size_t threads = static_cast<std::size_t>(state.range(0));
+  mixture_t initial;
+  initial.initialize(s, 50, threads);
+  for (auto _ : state) {
+    mixture_t mixture = initial;
+    mixture.fit(s, 1, T(), threads);
+    benchmark::DoNotOptimize(mixture.getLogLikelihood());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+/// log-likelihood of all samples, as accumulated by beam models
+template <typename T, std::size_t Dim>
+static void distribution_log_of_sample(benchmark::State &state) {
+  const auto s = samples<T, Dim>();
+  cslibs_math::statistics::Distribution<T, Dim> d;
+  d.add(s.begin(), s.end());
+  for (auto _ : state) {
+    T log_likelihood = T();
+    for (const auto &p : s) log_likelihood += std::log(d.sample(p));
+    benchmark::DoNotOptimize(log_likelihood);
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim>
+static void distribution_log_sample(benchmark::State &state) {
+  const auto s = samples<T, Dim>();
+  cslibs_math::statistics::Distribution<T, Dim> d;
+  d.add(s.begin(), s.end());
+  for (auto _ : state) {
+    T log_likelihood = T();
+    for (const auto &p : s) log_likelihood += d.logSample(p);
+    benchmark::DoNotOptimize(log_likelihood);
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim>
+static void distribution_sample(benchmark::State &state) {
+  const auto s = samples<T, Dim>();
+  cslibs_math::statistics::Distribution<T, Dim> d;
+  d.add(s.begin(), s.end());
+  std::vector<T> out(SAMPLES);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < SAMPLES; ++i) out[i] = d.sample(s[i]);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim>
+static void distribution_sample_batch(benchmark::State &state) {
+  using distribution_t = cslibs_math::statistics::Distribution<T, Dim>;
+  const auto m = matrix<T, Dim>(samples<T, Dim>());
+  distribution_t d;
+  d.add(m);
+  typename distribution_t::densities_t out;
+  for (auto _ : state) {
+    d.sample(m, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+/// pairwise distances between small distributions
+const std::size_t DISTRIBUTIONS = 256;
+
+template <typename T, std::size_t Dim>
+using distributions_t =
+    std::vector<cslibs_math::statistics::Distribution<T, Dim>,
+                typename cslibs_math::statistics::Distribution<T,
+                                                               Dim>::allocator_t>;
+
+template <typename T, std::size_t Dim>
+distributions_t<T, Dim> distributions() {
+  const auto s = samples<T, Dim>();
+  distributions_t<T, Dim> d(DISTRIBUTIONS);
+  const std::size_t n = SAMPLES / DISTRIBUTIONS;
+  for (std::size_t i = 0; i < DISTRIBUTIONS; ++i)
+    d[i].add(s.begin() + i * n, s.begin() + (i + 1) * n);
+  return d;
+}
+
+template <typename T, std::size_t Dim>
+static void bhattacharyya_pairs(benchmark::State &state) {
+  const auto d = distributions<T, Dim>();
+  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> out(DISTRIBUTIONS,
+                                                       DISTRIBUTIONS);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < DISTRIBUTIONS; ++i)
+      for (std::size_t j = i + 1; j < DISTRIBUTIONS; ++j)
+        out(i, j) = out(j, i) =
+            cslibs_math::statistics::bhattacharyya(d[i], d[j]);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * DISTRIBUTIONS *
+                          (DISTRIBUTIONS - 1) / 2);
+}
+
+template <typename T, std::size_t Dim>
+static void bhattacharyya_matrix(benchmark::State &state) {
+  const auto d = distributions<T, Dim>();
+  const std::size_t threads = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    const cslibs_math::statistics::BhattacharyyaMatrix<T, Dim> matrix(d);
+    benchmark::DoNotOptimize(matrix.dense(threads).data());
+  }
+  state.SetItemsProcessed(state.iterations() * DISTRIBUTIONS *
+                          (DISTRIBUTIONS - 1) / 2);
+}
+
+/// update() after every insertion, the factorization dominates
+template <typename T, std::size_t Dim>
+static void distribution_update(benchmark::State &state) {
+  auto d = distributions<T, Dim>();
+  const auto s = samples<T, Dim>();
+  std::size_t k = 0;
+  for (auto _ : state) {
+    for (auto &distribution : d) {
+      distribution.add(s[k++ % SAMPLES]);
+      benchmark::DoNotOptimize(distribution.denominator());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * DISTRIBUTIONS);
+}
+
+template <typename T, std::size_t Dim>
+using covariances_t =
+    std::vector<Eigen::Matrix<T, Dim, Dim>,
+                Eigen::aligned_allocator<Eigen::Matrix<T, Dim, Dim>>>;
+
+template <typename T, std::size_t Dim>
+covariances_t<T, Dim> covariances() {
+  const auto d = distributions<T, Dim>();
+  covariances_t<T, Dim> c;
+  for (const auto &distribution : d)
+    c.emplace_back(distribution.getCovariance());
+  return c;
+}
+
+/// generic Eigen factorization for comparison with linear::Cholesky
+template <typename T, std::size_t Dim>
+static void cholesky_llt(benchmark::State &state) {
+  using matrix_t = Eigen::Matrix<T, Dim, Dim>;
+  const auto c = covariances<T, Dim>();
+  matrix_t lower, inverse;
+  for (auto _ : state) {
+    for (const auto &m : c) {
+      const Eigen::LLT<matrix_t> llt(m);
+      lower = llt.matrixL();
+      inverse = llt.solve(matrix_t::Identity());
+      benchmark::DoNotOptimize(lower.data());
+      benchmark::DoNotOptimize(inverse.data());
+      benchmark::DoNotOptimize(
+          T(2) * lower.diagonal().array().log().sum());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * DISTRIBUTIONS);
+}
+
+template <typename T, std::size_t Dim>
+static void cholesky(benchmark::State &state) {
+  using matrix_t = Eigen::Matrix<T, Dim, Dim>;
+  const auto c = covariances<T, Dim>();
+  matrix_t lower, inverse;
+  T determinant, log_determinant;
+  for (auto _ : state) {
+    for (const auto &m : c) {
+      cslibs_math::linear::Cholesky<T, Dim>::compute(
+          m, lower, inverse, determinant, log_determinant);
+      benchmark::DoNotOptimize(lower.data());
+      benchmark::DoNotOptimize(inverse.data());
+      benchmark::DoNotOptimize(log_determinant);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * DISTRIBUTIONS);
+}
+
+template <typename T>
+static void histogram_add(benchmark::State &state) {
+  const std::vector<T> s = weights<T>();
+  for (auto _ : state) {
+    cslibs_math::statistics::Histogram<T> h(0.0, 1.0, 100);
+    for (const T v : s) h.add(v);
+    benchmark::DoNotOptimize(h.getCounts().data());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T>
+static void histogram_add_batch(benchmark::State &state) {
+  const std::vector<T> w = weights<T>();
+  const typename cslibs_math::statistics::Histogram<T>::values_t s =
+      Eigen::Map<const typename cslibs_math::statistics::Histogram<
+          T>::values_t>(w.data(), w.size());
+  for (auto _ : state) {
+    cslibs_math::statistics::Histogram<T> h(0.0, 1.0, 100);
+    h.add(s);
+    benchmark::DoNotOptimize(h.getCounts().data());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+template <typename T, std::size_t Dim>
+using weighted_t = cslibs_math::statistics::WeightedDistribution<T, Dim>;
+template <typename T, std::size_t Dim>
+using stable_weighted_t =
+    cslibs_math::statistics::StableWeightedDistribution<T, Dim>;
+
+BENCHMARK_TEMPLATE(distribution_add, double, 2);
+BENCHMARK_TEMPLATE(distribution_add_range, double, 2);
+BENCHMARK_TEMPLATE(distribution_add_matrix, double, 2);
+BENCHMARK_TEMPLATE(distribution_add, double, 3);
+BENCHMARK_TEMPLATE(distribution_add_range, double, 3);
+BENCHMARK_TEMPLATE(distribution_add_matrix, double, 3);
+BENCHMARK_TEMPLATE(distribution_parallel_accumulate, double, 3)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(gaussian_mixture_iteration, double, 3)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(distribution_log_of_sample, double, 2);
+BENCHMARK_TEMPLATE(distribution_log_sample, double, 2);
+BENCHMARK_TEMPLATE(distribution_log_of_sample, double, 3);
+BENCHMARK_TEMPLATE(distribution_log_sample, double, 3);
+BENCHMARK_TEMPLATE(distribution_sample, double, 2);
+BENCHMARK_TEMPLATE(distribution_sample_batch, double, 2);
+BENCHMARK_TEMPLATE(distribution_sample, double, 3);
+BENCHMARK_TEMPLATE(distribution_sample_batch, double, 3);
+BENCHMARK_TEMPLATE(bhattacharyya_pairs, double, 2);
+BENCHMARK_TEMPLATE(bhattacharyya_matrix, double, 2)
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(bhattacharyya_pairs, double, 3);
+BENCHMARK_TEMPLATE(bhattacharyya_matrix, double, 3)
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(cholesky_llt, float, 2);
+BENCHMARK_TEMPLATE(cholesky, float, 2);
+BENCHMARK_TEMPLATE(cholesky_llt, float, 3);
+BENCHMARK_TEMPLATE(cholesky, float, 3);
+BENCHMARK_TEMPLATE(cholesky_llt, double, 2);
+BENCHMARK_TEMPLATE(cholesky, double, 2);
+BENCHMARK_TEMPLATE(cholesky_llt, double, 3);
+BENCHMARK_TEMPLATE(cholesky, double, 3);
+BENCHMARK_TEMPLATE(distribution_update, float, 2);
+BENCHMARK_TEMPLATE(distribution_update, float, 3);
+BENCHMARK_TEMPLATE(distribution_update, double, 2);
+BENCHMARK_TEMPLATE(distribution_update, double, 3);
+BENCHMARK_TEMPLATE(histogram_add, float);
+BENCHMARK_TEMPLATE(histogram_add_batch, float);
+BENCHMARK_TEMPLATE(histogram_add, double);
+BENCHMARK_TEMPLATE(histogram_add_batch, double);
+BENCHMARK_TEMPLATE(weighted_add, double, 3, weighted_t);
+BENCHMARK_TEMPLATE(weighted_add_range, double, 3, weighted_t);
+BENCHMARK_TEMPLATE(weighted_add_matrix, double, 3, weighted_t);
+BENCHMARK_TEMPLATE(weighted_add, double, 3, stable_weighted_t);
+BENCHMARK_TEMPLATE(weighted_add_range, double, 3, stable_weighted_t);
+BENCHMARK_TEMPLATE(weighted_add_matrix, double, 3, stable_weighted_t);
+
+BENCHMARK_MAIN();
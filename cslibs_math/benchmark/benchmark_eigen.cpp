@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <cslibs_math/linear/symmetric_eigen.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <vector>
+
+/// each iteration decomposes a batch of random covariance matrices, the
+/// counters report the worst residual |A v - lambda v| of the batch
+const std::size_t BATCH = 1024;
+
+template <typename T, std::size_t Dim>
+using matrices_t =
+    std::vector<Eigen::Matrix<T, Dim, Dim>,
+                Eigen::aligned_allocator<Eigen::Matrix<T, Dim, Dim>>>;
+
+template <typename T, std::size_t Dim>
+matrices_t<T, Dim> covariances() {
+  cslibs_math::random::Uniform<T, 1> rng(-10.0, 10.0, 42);
+  matrices_t<T, Dim> matrices(BATCH);
+  for (auto &m : matrices) {
+    Eigen::Matrix<T, Dim, Dim> a;
+    for (std::size_t i = 0; i < Dim; ++i)
+      for (std::size_t j = 0; j < Dim; ++j) a(i, j) = rng.get();
+    m = a * a.transpose();
+  }
+  return matrices;
+}
+
+template <typename T, std::size_t Dim>
+T residual(const Eigen::Matrix<T, Dim, Dim> &m,
+           const Eigen::Matrix<T, Dim, 1> &values,
+           const Eigen::Matrix<T, Dim, Dim> &vectors) {
+  return (m * vectors - vectors * values.asDiagonal()).cwiseAbs().maxCoeff() /
+         m.cwiseAbs().maxCoeff();
+}
+
+template <typename T, std::size_t Dim>
+static void eigen_solver(benchmark::State &state) {
+  const auto matrices = covariances<T, Dim>();
+  T error = T();
+  for (auto _ : state) {
+    for (const auto &m : matrices) {
+      Eigen::EigenSolver<Eigen::Matrix<T, Dim, Dim>> solver(m);
+      const Eigen::Matrix<T, Dim, 1> values = solver.eigenvalues().real();
+      const Eigen::Matrix<T, Dim, Dim> vectors = solver.eigenvectors().real();
+      benchmark::DoNotOptimize(values);
+      benchmark::DoNotOptimize(vectors);
+      error = std::max(error, residual<T, Dim>(m, values, vectors));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH);
+  state.counters["max_residual"] = error;
+}
+
+template <typename T, std::size_t Dim>
+static void self_adjoint_eigen_solver(benchmark::State &state) {
+  const auto matrices = covariances<T, Dim>();
+  T error = T();
+  for (auto _ : state) {
+    for (const auto &m : matrices) {
+      Eigen::SelfAdjointEigenSolver<Eigen::Matrix<T, Dim, Dim>> solver(m);
+      benchmark::DoNotOptimize(solver.eigenvalues());
+      error = std::max(error, residual<T, Dim>(m, solver.eigenvalues(),
+                                               solver.eigenvectors()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH);
+  state.counters["max_residual"] = error;
+}
+
+template <typename T, std::size_t Dim>
+static void symmetric_eigen(benchmark::State &state) {
+  using solver_t = cslibs_math::linear::SymmetricEigen<T, Dim>;
+  const auto matrices = covariances<T, Dim>();
+  T error = T();
+  for (auto _ : state) {
+    for (const auto &m : matrices) {
+      typename solver_t::eigen_values_t values;
+      typename solver_t::eigen_vectors_t vectors;
+      solver_t::compute(m, values, vectors);
+      benchmark::DoNotOptimize(values);
+      benchmark::DoNotOptimize(vectors);
+      error = std::max(error, residual<T, Dim>(m, values, vectors));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * BATCH);
+  state.counters["max_residual"] = error;
+}
+
+BENCHMARK_TEMPLATE(eigen_solver, double, 2);
+BENCHMARK_TEMPLATE(self_adjoint_eigen_solver, double, 2);
+BENCHMARK_TEMPLATE(symmetric_eigen, double, 2);
+BENCHMARK_TEMPLATE(eigen_solver, double, 3);
+BENCHMARK_TEMPLATE(self_adjoint_eigen_solver, double, 3);
+BENCHMARK_TEMPLATE(symmetric_eigen, double, 3);
+BENCHMARK_TEMPLATE(eigen_solver, float, 2);
+BENCHMARK_TEMPLATE(self_adjoint_eigen_solver, float, 2);
+BENCHMARK_TEMPLATE(symmetric_eigen, float, 2);
+BENCHMARK_TEMPLATE(eigen_solver, float, 3);
+BENCHMARK_TEMPLATE(self_adjoint_eigen_solver, float, 3);
+BENCHMARK_TEMPLATE(symmetric_eigen, float, 3);
+
+BENCHMARK_MAIN();
@@ -2,7 +2,32 @@
 
 #include <cslibs_math/random/random.hpp>
 #include <cslibs_math/approx/exp.hpp>
+#include <cslibs_math/approx/log.hpp>
 #include <cslibs_math/utility/tiny_time.hpp>
+#include <algorithm>
+#include <vector>
+
+/// bulk kernels are evaluated over arrays of this size, e.g. one beam set
+const std::size_t BULK_SIZE = 4096;
+
+template <typename T>
+std::vector<T> bulkInput() {
+  cslibs_math::random::Uniform<double, 1> rng(-80.0, 0.0, 42);
+  std::vector<T> in(BULK_SIZE);
+  for (T& v : in) v = static_cast<T>(rng.get());
+  return in;
+}
+
+/// maximum relative error against double precision std::exp
+template <typename T>
+double maxRelativeError(const std::vector<T>& in, const std::vector<T>& out) {
+  double error = 0.0;
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    const double expected = std::exp(static_cast<double>(in[i]));
+    error = std::max(error, std::abs(out[i] / expected - 1.0));
+  }
+  return error;
+}
 
 static void std_exp(benchmark::State& state) {
   cslibs_math::random::Uniform<double, 1> rng(-100.0, +100.0);
@@ -136,6 +161,146 @@ static void approx_exp_40(benchmark::State& state) {
 #endif
 }
 
+template <typename T>
+static void bulk_std_exp(benchmark::State& state) {
+  const std::vector<T> in = bulkInput<T>();
+  std::vector<T> out(BULK_SIZE);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < BULK_SIZE; ++i) out[i] = std::exp(in[i]);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * BULK_SIZE);
+  state.counters["max_rel_error"] = maxRelativeError(in, out);
+}
+
+template <typename T>
+static void bulk_eigen_exp(benchmark::State& state) {
+  using array_t = Eigen::Array<T, Eigen::Dynamic, 1>;
+  const std::vector<T> in = bulkInput<T>();
+  std::vector<T> out(BULK_SIZE);
+  const Eigen::Map<const array_t> in_map(in.data(), BULK_SIZE);
+  Eigen::Map<array_t> out_map(out.data(), BULK_SIZE);
+  for (auto _ : state) {
+    out_map = in_map.exp();
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * BULK_SIZE);
+  state.counters["max_rel_error"] = maxRelativeError(in, out);
+}
+
+template <typename T, cslibs_math::approx::ExpAccuracy Accuracy>
+static void bulk_approx_exp(benchmark::State& state) {
+  const std::vector<T> in = bulkInput<T>();
+  std::vector<T> out(BULK_SIZE);
+  for (auto _ : state) {
+    cslibs_math::approx::exp<Accuracy>(in.data(), out.data(), BULK_SIZE);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * BULK_SIZE);
+  state.counters["max_rel_error"] = maxRelativeError(in, out);
+}
+
+template <typename T>
+std::vector<T> bulkLogInput() {
+  cslibs_math::random::Uniform<double, 1> rng(-80.0, 80.0, 42);
+  std::vector<T> in(BULK_SIZE);
+  for (T& v : in) v = static_cast<T>(std::exp(rng.get()));
+  return in;
+}
+
+/// maximum absolute error against double precision std::log
+template <typename T>
+double maxLogError(const std::vector<T>& in, const std::vector<T>& out) {
+  double error = 0.0;
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    error = std::max(
+        error, std::abs(out[i] - std::log(static_cast<double>(in[i]))));
+  }
+  return error;
+}
+
+template <typename T>
+static void bulk_std_log(benchmark::State& state) {
+  const std::vector<T> in = bulkLogInput<T>();
+  std::vector<T> out(BULK_SIZE);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < BULK_SIZE; ++i) out[i] = std::log(in[i]);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * BULK_SIZE);
+  state.counters["max_abs_error"] = maxLogError(in, out);
+}
+
+template <typename T, cslibs_math::approx::ExpAccuracy Accuracy>
+static void bulk_approx_log(benchmark::State& state) {
+  using fast_log_t = cslibs_math::approx::detail::FastLog<T, Accuracy>;
+  const std::vector<T> in = bulkLogInput<T>();
+  std::vector<T> out(BULK_SIZE);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < BULK_SIZE; ++i)
+      out[i] = fast_log_t::eval(in[i]);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * BULK_SIZE);
+  state.counters["max_abs_error"] = maxLogError(in, out);
+}
+
+template <typename T, cslibs_math::approx::ExpAccuracy Accuracy>
+static void log_sum_exp(benchmark::State& state) {
+  const std::vector<T> in = bulkInput<T>();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        cslibs_math::approx::logSumExp<Accuracy>(in.data(), BULK_SIZE));
+  }
+  state.SetItemsProcessed(state.iterations() * BULK_SIZE);
+}
+
+/// particle log-weights, the argument is the number of particles
+template <typename T>
+std::vector<T> particleLogWeights(const std::size_t n) {
+  cslibs_math::random::Uniform<double, 1> rng(-500.0, 0.0, 42);
+  std::vector<T> log_weights(n);
+  for (T& v : log_weights) v = static_cast<T>(rng.get());
+  return log_weights;
+}
+
+/// the scalar max-subtract-exp-sum loop normalizeLogWeights replaces
+template <typename T>
+static void normalize_log_weights_scalar(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> log_weights = particleLogWeights<T>(n);
+  std::vector<T> weights(n);
+  for (auto _ : state) {
+    const T max = *std::max_element(log_weights.begin(), log_weights.end());
+    T sum = T();
+    for (std::size_t i = 0; i < n; ++i) {
+      weights[i] = std::exp(log_weights[i] - max);
+      sum += weights[i];
+    }
+    for (T& w : weights) w /= sum;
+    benchmark::DoNotOptimize(weights.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// arguments are the number of particles and threads
+template <typename T, cslibs_math::approx::ExpAccuracy Accuracy>
+static void normalize_log_weights(benchmark::State& state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::size_t threads = static_cast<std::size_t>(state.range(1));
+  const std::vector<T> log_weights = particleLogWeights<T>(n);
+  std::vector<T> weights(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cslibs_math::approx::normalizeLogWeights<Accuracy>(
+        log_weights.data(), weights.data(), n, threads));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
 
 static void std_log(benchmark::State& state) {
   cslibs_math::random::Uniform<double, 1> rng(-100.0, +100.0);
@@ -190,8 +355,55 @@ BENCHMARK(approx_exp_10);
 BENCHMARK(approx_exp_20);
 BENCHMARK(approx_exp_40);
 
+using cslibs_math::approx::ExpAccuracy;
+BENCHMARK_TEMPLATE(bulk_std_exp, float);
+BENCHMARK_TEMPLATE(bulk_eigen_exp, float);
+BENCHMARK_TEMPLATE(bulk_approx_exp, float, ExpAccuracy::Coarse);
+BENCHMARK_TEMPLATE(bulk_approx_exp, float, ExpAccuracy::Fine);
+BENCHMARK_TEMPLATE(bulk_approx_exp, float, ExpAccuracy::Full);
+BENCHMARK_TEMPLATE(bulk_std_exp, double);
+BENCHMARK_TEMPLATE(bulk_eigen_exp, double);
+BENCHMARK_TEMPLATE(bulk_approx_exp, double, ExpAccuracy::Coarse);
+BENCHMARK_TEMPLATE(bulk_approx_exp, double, ExpAccuracy::Fine);
+BENCHMARK_TEMPLATE(bulk_approx_exp, double, ExpAccuracy::Full);
+
 BENCHMARK(std_log);
 BENCHMARK(std_log2);
 BENCHMARK(c_log);
+BENCHMARK_TEMPLATE(bulk_std_log, float);
+BENCHMARK_TEMPLATE(bulk_approx_log, float, ExpAccuracy::Coarse);
+BENCHMARK_TEMPLATE(bulk_approx_log, float, ExpAccuracy::Fine);
+BENCHMARK_TEMPLATE(bulk_std_log, double);
+BENCHMARK_TEMPLATE(bulk_approx_log, double, ExpAccuracy::Coarse);
+BENCHMARK_TEMPLATE(bulk_approx_log, double, ExpAccuracy::Fine);
+BENCHMARK_TEMPLATE(bulk_approx_log, double, ExpAccuracy::Full);
+BENCHMARK_TEMPLATE(log_sum_exp, float, ExpAccuracy::Coarse);
+BENCHMARK_TEMPLATE(log_sum_exp, float, ExpAccuracy::Full);
+BENCHMARK_TEMPLATE(log_sum_exp, double, ExpAccuracy::Coarse);
+BENCHMARK_TEMPLATE(log_sum_exp, double, ExpAccuracy::Full);
+
+BENCHMARK_TEMPLATE(normalize_log_weights_scalar, float)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(normalize_log_weights, float, ExpAccuracy::Fine)
+    ->Args({1000, 1})
+    ->Args({100000, 1})
+    ->Args({1000000, 1})
+    ->Args({1000000, 4});
+BENCHMARK_TEMPLATE(normalize_log_weights_scalar, double)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(normalize_log_weights, double, ExpAccuracy::Fine)
+    ->Args({1000, 1})
+    ->Args({100000, 1})
+    ->Args({1000000, 1})
+    ->Args({1000000, 4});
+BENCHMARK_TEMPLATE(normalize_log_weights, double, ExpAccuracy::Full)
+    ->Args({1000, 1})
+    ->Args({100000, 1})
+    ->Args({1000000, 1})
+    ->Args({1000000, 4});
 
 BENCHMARK_MAIN();
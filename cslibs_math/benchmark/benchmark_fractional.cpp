@@ -7,6 +7,7 @@
 #include <cslibs_math/utility/tiny_time.hpp>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 
 using Fractionald = cslibs_math::approx::Fractional<double>;
 
@@ -30,7 +31,7 @@ const auto SAMPLING_ITERATIONS = 60;
 static void applicationFractional(benchmark::State& state) {
   auto task = [&state]() {
     cslibs_math::random::Uniform<double, 1> rng(0.0, 1.0);
-    cslibs_math::utility::tiny_time::duration_t elapsed;
+    cslibs_math::utility::tiny_time::duration_t elapsed{};
 
     const auto sample = [&rng]() {
       Fractionald s(1.0);
@@ -80,7 +81,7 @@ static void applicationLog(benchmark::State& state) {
     using Log2d = cslibs_math::approx::Log<double>;
 
     cslibs_math::random::Uniform<double, 1> rng(0.0, 1.0);
-    cslibs_math::utility::tiny_time::duration_t elapsed;
+    cslibs_math::utility::tiny_time::duration_t elapsed{};
 
     const auto sample = [&rng]() {
       Log2d s{1.0};
@@ -132,7 +133,7 @@ static void applicationLog(benchmark::State& state) {
 static void applicationPlainLog(benchmark::State& state) {
   auto task = [&state]() {
     cslibs_math::random::Uniform<double, 1> rng(0.0, 1.0);
-    cslibs_math::utility::tiny_time::duration_t elapsed;
+    cslibs_math::utility::tiny_time::duration_t elapsed{};
 
     const auto add = [](const double x, const double y) {
       /// x and y are log values
@@ -185,7 +186,7 @@ static void applicationPlainLog(benchmark::State& state) {
 static void applicationDefault(benchmark::State& state) {
   auto task = [&state]() {
     cslibs_math::random::Uniform<double, 1> rng(0.0, 1.0);
-    cslibs_math::utility::tiny_time::duration_t elapsed;
+    cslibs_math::utility::tiny_time::duration_t elapsed{};
 
     const auto sample = [&rng]() {
       auto s(1.0);
@@ -230,10 +231,71 @@ static void applicationDefault(benchmark::State& state) {
   }
 }
 
+/// one scan of beam likelihoods of a particle
+const std::size_t BEAMS = 1080;
+
+template <typename T>
+std::vector<T> beamLikelihoods() {
+  cslibs_math::random::Uniform<double, 1> rng(1e-3, 1.0, 42);
+  std::vector<T> likelihoods(BEAMS);
+  for (T& l : likelihoods) l = static_cast<T>(rng.get());
+  return likelihoods;
+}
+
+static void beam_product_fractional(benchmark::State& state) {
+  const auto likelihoods = beamLikelihoods<double>();
+  for (auto _ : state) {
+    Fractionald p(1.0);
+    for (const double l : likelihoods) p = p * Fractionald(l);
+    benchmark::DoNotOptimize(p);
+  }
+  state.SetItemsProcessed(state.iterations() * BEAMS);
+}
+
+template <typename T>
+static void beam_product_log(benchmark::State& state) {
+  const auto likelihoods = beamLikelihoods<T>();
+  for (auto _ : state) {
+    T p = T();
+    for (const T l : likelihoods) p += std::log(l);
+    benchmark::DoNotOptimize(p);
+  }
+  state.SetItemsProcessed(state.iterations() * BEAMS);
+}
+
+template <typename T>
+static void beam_product_fractional_product(benchmark::State& state) {
+  const auto likelihoods = beamLikelihoods<T>();
+  for (auto _ : state) {
+    cslibs_math::approx::FractionalProduct<T> p;
+    p.multiply(likelihoods.data(), BEAMS);
+    benchmark::DoNotOptimize(p.get());
+  }
+  state.SetItemsProcessed(state.iterations() * BEAMS);
+}
+
+template <typename T>
+static void beam_product_fractional_product_scalar(benchmark::State& state) {
+  const auto likelihoods = beamLikelihoods<T>();
+  for (auto _ : state) {
+    cslibs_math::approx::FractionalProduct<T> p;
+    for (const T l : likelihoods) p *= l;
+    benchmark::DoNotOptimize(p.get());
+  }
+  state.SetItemsProcessed(state.iterations() * BEAMS);
+}
+
 BENCHMARK(fractional_constructor_default);
 BENCHMARK(applicationFractional);
 BENCHMARK(applicationLog);
 BENCHMARK(applicationPlainLog);
 BENCHMARK(applicationDefault);
+BENCHMARK(beam_product_fractional);
+BENCHMARK_TEMPLATE(beam_product_log, float);
+BENCHMARK_TEMPLATE(beam_product_fractional_product, float);
+BENCHMARK_TEMPLATE(beam_product_fractional_product_scalar, float);
+BENCHMARK_TEMPLATE(beam_product_log, double);
+BENCHMARK_TEMPLATE(beam_product_fractional_product, double);
+BENCHMARK_TEMPLATE(beam_product_fractional_product_scalar, double);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <cslibs_math/common/log_odds.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/// rays from the center of a square grid, the argument is its side length
+const std::size_t RAYS = 1080;
+const double RANGE = 400.0;
+const float P_HIT = 0.7f;
+const float P_MISS = 0.4f;
+const float MIN_LOG_ODDS = -2.0f;
+const float MAX_LOG_ODDS = 3.5f;
+
+using log_odds_t =
+    cslibs_math::common::LogOddsFixed<std::int16_t,
+                                      cslibs_math::common::LogOddsScale<11>,
+                                      cslibs_math::common::LogOddsClamp>;
+
+/// cell indices of each ray, the last one is the hit, the major axis
+/// advances by one cell per step, so no cell repeats within a ray
+std::vector<std::vector<std::uint32_t>> rays(const std::size_t side) {
+  cslibs_math::random::Uniform<double, 1> rng_angle(-M_PI, M_PI, 42);
+  cslibs_math::random::Uniform<double, 1> rng_range(0.5 * RANGE, RANGE, 43);
+  const double center = 0.5 * static_cast<double>(side);
+  std::vector<std::vector<std::uint32_t>> result(RAYS);
+  for (auto &ray : result) {
+    const double angle = rng_angle.get();
+    const double dx = std::cos(angle);
+    const double dy = std::sin(angle);
+    const double step = 1.0 / std::max(std::abs(dx), std::abs(dy));
+    const double range = std::min(rng_range.get(), center - 1.0);
+    for (double t = 0.0; t < range; t += step) {
+      const auto x = static_cast<std::uint32_t>(center + t * dx);
+      const auto y = static_cast<std::uint32_t>(center + t * dy);
+      ray.emplace_back(y * static_cast<std::uint32_t>(side) + x);
+    }
+  }
+  return result;
+}
+
+static void ray_update_float(benchmark::State &state) {
+  const std::size_t side = static_cast<std::size_t>(state.range(0));
+  const auto indices = rays(side);
+  const float hit = cslibs_math::common::LogOdds<float>::to(P_HIT);
+  const float miss = cslibs_math::common::LogOdds<float>::to(P_MISS);
+  std::vector<float> cells(side * side, 0.0f);
+  std::size_t updates = 0;
+  for (auto _ : state) {
+    for (const auto &ray : indices) {
+      const std::size_t n = ray.size() - 1;
+      for (std::size_t i = 0; i < n; ++i) {
+        float &c = cells[ray[i]];
+        c = std::max(c + miss, MIN_LOG_ODDS);
+      }
+      float &c = cells[ray[n]];
+      c = std::min(c + hit, MAX_LOG_ODDS);
+      updates += ray.size();
+    }
+    benchmark::DoNotOptimize(cells.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(updates);
+  state.counters["grid_bytes"] = sizeof(float) * cells.size();
+}
+
+static void ray_update_fixed(benchmark::State &state) {
+  const std::size_t side = static_cast<std::size_t>(state.range(0));
+  const auto indices = rays(side);
+  const log_odds_t model(P_HIT, P_MISS);
+  std::vector<std::int16_t> cells(side * side, 0);
+  std::size_t updates = 0;
+  for (auto _ : state) {
+    for (const auto &ray : indices) {
+      const std::size_t n = ray.size() - 1;
+      log_odds_t::update(cells.data(), ray.data(), n, model.miss());
+      cells[ray[n]] = log_odds_t::update(cells[ray[n]], model.hit());
+      updates += ray.size();
+    }
+    benchmark::DoNotOptimize(cells.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(updates);
+  state.counters["grid_bytes"] = sizeof(std::int16_t) * cells.size();
+}
+
+/// occupancy probabilities of the cells along the rays, e.g. for a beam
+/// model evaluating a map
+static void probability_exact(benchmark::State &state) {
+  const std::size_t side = static_cast<std::size_t>(state.range(0));
+  const auto indices = rays(side);
+  cslibs_math::random::Uniform<double, 1> rng(-2.0, 3.5, 42);
+  std::vector<float> cells(side * side);
+  for (float &c : cells) c = static_cast<float>(rng.get());
+  std::size_t lookups = 0;
+  for (auto _ : state) {
+    for (const auto &ray : indices) {
+      float p = 1.0f;
+      for (const auto i : ray)
+        p *= cslibs_math::common::LogOdds<float>::from(cells[i]);
+      benchmark::DoNotOptimize(p);
+      lookups += ray.size();
+    }
+  }
+  state.SetItemsProcessed(lookups);
+}
+
+static void probability_table(benchmark::State &state) {
+  const std::size_t side = static_cast<std::size_t>(state.range(0));
+  const auto indices = rays(side);
+  cslibs_math::random::Uniform<double, 1> rng(-2.0, 3.5, 42);
+  std::vector<std::int16_t> cells(side * side);
+  for (auto &c : cells)
+    c = log_odds_t::quantize(static_cast<float>(rng.get()));
+  const log_odds_t model(P_HIT, P_MISS);
+  std::size_t lookups = 0;
+  for (auto _ : state) {
+    for (const auto &ray : indices) {
+      float p = 1.0f;
+      for (const auto i : ray) p *= model.probability(cells[i]);
+      benchmark::DoNotOptimize(p);
+      lookups += ray.size();
+    }
+  }
+  state.SetItemsProcessed(lookups);
+}
+
+BENCHMARK(ray_update_float)->Arg(1024)->Arg(4096);
+BENCHMARK(ray_update_fixed)->Arg(1024)->Arg(4096);
+BENCHMARK(probability_exact)->Arg(1024);
+BENCHMARK(probability_table)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <random>
+
+const std::size_t PARTICLES = 1000;
+const std::size_t SAMPLES = 1000;
+
+/// samples of a single generator
+template <typename Generator>
+static void sample(benchmark::State &state) {
+  cslibs_math::random::Normal<double, 1, Generator> rng(0.0, 1.0, 42u);
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < SAMPLES; ++i) sum += rng.get();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+
+/// a reproducible generator per particle, e.g. for a parallel motion update
+static void particle_mt19937_64(benchmark::State &state) {
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (std::size_t p = 0; p < PARTICLES; ++p) {
+      cslibs_math::random::Normal<double, 1> rng(
+          0.0, 1.0, static_cast<unsigned int>(p));
+      sum += rng.get();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * PARTICLES);
+}
+
+static void particle_philox(benchmark::State &state) {
+  using philox_t = cslibs_math::random::Philox4x32;
+  const philox_t seed(42);
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (std::size_t p = 0; p < PARTICLES; ++p) {
+      cslibs_math::random::Normal<double, 1, philox_t> rng(0.0, 1.0,
+                                                           seed.split(p));
+      sum += rng.get();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * PARTICLES);
+}
+
+BENCHMARK_TEMPLATE(sample, std::mt19937_64);
+BENCHMARK_TEMPLATE(sample, cslibs_math::random::Philox4x32);
+BENCHMARK(particle_mt19937_64);
+BENCHMARK(particle_philox);
+
+BENCHMARK_MAIN();
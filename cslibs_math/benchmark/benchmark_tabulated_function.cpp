@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include <cslibs_math/approx/exp.hpp>
+#include <cslibs_math/approx/tabulated_function.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <vector>
+
+using cslibs_math::approx::ExpAccuracy;
+using cslibs_math::approx::Interpolation;
+
+/// distances of one beam set, bounded by the kernel cutoff
+const std::size_t DISTANCES = 4096;
+const double SIGMA = 0.5;
+const double CUTOFF = 4.0;
+
+template <typename T>
+std::vector<T> distances() {
+  cslibs_math::random::Uniform<double, 1> rng(0.0, CUTOFF * SIGMA, 42);
+  std::vector<T> d(DISTANCES);
+  for (T& v : d) v = static_cast<T>(rng.get());
+  return d;
+}
+
+/// maximum absolute error against the double precision Gaussian
+template <typename T>
+double maxAbsoluteError(const std::vector<T>& d, const std::vector<T>& out) {
+  double error = 0.0;
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    const double x = static_cast<double>(d[i]) / SIGMA;
+    error = std::max(error, std::abs(out[i] - std::exp(-0.5 * x * x)));
+  }
+  return error;
+}
+
+template <typename T>
+static void gaussian_std_exp(benchmark::State& state) {
+  const auto d = distances<T>();
+  std::vector<T> out(DISTANCES);
+  const T scale = T(-0.5) / T(SIGMA * SIGMA);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < DISTANCES; ++i)
+      out[i] = std::exp(scale * d[i] * d[i]);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * DISTANCES);
+  state.counters["max_abs_error"] = maxAbsoluteError(d, out);
+}
+
+template <typename T, ExpAccuracy Accuracy>
+static void gaussian_approx_exp(benchmark::State& state) {
+  const auto d = distances<T>();
+  std::vector<T> out(DISTANCES);
+  const T scale = T(-0.5) / T(SIGMA * SIGMA);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < DISTANCES; ++i) out[i] = scale * d[i] * d[i];
+    cslibs_math::approx::exp<Accuracy>(out.data(), out.data(), DISTANCES);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * DISTANCES);
+  state.counters["max_abs_error"] = maxAbsoluteError(d, out);
+}
+
+template <typename T>
+static void gaussian_distribution(benchmark::State& state) {
+  using distribution_t = cslibs_math::statistics::Distribution<T, 1>;
+  const auto d = distances<T>();
+  std::vector<T> out(DISTANCES);
+  distribution_t distribution;
+  /// mean 0 and unbiased variance SIGMA^2 / 2, the one-dimensional
+  /// sampleNonNormalized divides by twice the variance
+  distribution.add(T(0.5 * SIGMA));
+  distribution.add(T(-0.5 * SIGMA));
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < DISTANCES; ++i)
+      out[i] = distribution.sampleNonNormalized(d[i]);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * DISTANCES);
+  state.counters["max_abs_error"] = maxAbsoluteError(d, out);
+}
+
+template <typename T, std::size_t N, Interpolation I>
+static void gaussian_kernel(benchmark::State& state) {
+  const auto d = distances<T>();
+  std::vector<T> out(DISTANCES);
+  const cslibs_math::approx::GaussianKernel<T, N, I> kernel{T(SIGMA),
+                                                            T(CUTOFF)};
+  for (auto _ : state) {
+    kernel(d.data(), out.data(), DISTANCES);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * DISTANCES);
+  state.counters["max_abs_error"] = maxAbsoluteError(d, out);
+  state.counters["table_bytes"] = static_cast<double>(sizeof(kernel));
+}
+
+BENCHMARK_TEMPLATE(gaussian_std_exp, float);
+BENCHMARK_TEMPLATE(gaussian_approx_exp, float, ExpAccuracy::Fine);
+BENCHMARK_TEMPLATE(gaussian_distribution, float);
+BENCHMARK_TEMPLATE(gaussian_kernel, float, 64, Interpolation::Linear);
+BENCHMARK_TEMPLATE(gaussian_kernel, float, 256, Interpolation::Linear);
+BENCHMARK_TEMPLATE(gaussian_kernel, float, 1024, Interpolation::Linear);
+BENCHMARK_TEMPLATE(gaussian_kernel, float, 4096, Interpolation::Linear);
+BENCHMARK_TEMPLATE(gaussian_kernel, float, 64, Interpolation::Cubic);
+BENCHMARK_TEMPLATE(gaussian_kernel, float, 256, Interpolation::Cubic);
+BENCHMARK_TEMPLATE(gaussian_std_exp, double);
+BENCHMARK_TEMPLATE(gaussian_approx_exp, double, ExpAccuracy::Fine);
+BENCHMARK_TEMPLATE(gaussian_approx_exp, double, ExpAccuracy::Full);
+BENCHMARK_TEMPLATE(gaussian_distribution, double);
+BENCHMARK_TEMPLATE(gaussian_kernel, double, 64, Interpolation::Linear);
+BENCHMARK_TEMPLATE(gaussian_kernel, double, 256, Interpolation::Linear);
+BENCHMARK_TEMPLATE(gaussian_kernel, double, 1024, Interpolation::Linear);
+BENCHMARK_TEMPLATE(gaussian_kernel, double, 4096, Interpolation::Linear);
+BENCHMARK_TEMPLATE(gaussian_kernel, double, 64, Interpolation::Cubic);
+BENCHMARK_TEMPLATE(gaussian_kernel, double, 256, Interpolation::Cubic);
+BENCHMARK_TEMPLATE(gaussian_kernel, double, 1024, Interpolation::Cubic);
+
+BENCHMARK_MAIN();
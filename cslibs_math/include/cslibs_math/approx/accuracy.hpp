@@ -0,0 +1,18 @@
+#ifndef CSLIBS_MATH_ACCURACY_HPP
+#define CSLIBS_MATH_ACCURACY_HPP
+
+namespace cslibs_math {
+namespace approx {
+/**
+ * @brief Accuracy tiers of the polynomial kernels, the maximum relative
+ *        errors of the polynomials are about
+ *        Coarse - 1e-4
+ *        Fine   - 1e-7
+ *        Full   - machine precision of the scalar type
+ *        see minimax_coefficients.hpp for the bounds of each kernel.
+ */
+enum class ExpAccuracy { Coarse, Fine, Full };
+}  // namespace approx
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_ACCURACY_HPP
@@ -1,7 +1,13 @@
 #ifndef CSLIBS_MATH_EXP_HPP
 #define CSLIBS_MATH_EXP_HPP
 
+#include <cmath>
+#include <cslibs_math/approx/accuracy.hpp>
+#include <cslibs_math/approx/minimax_coefficients.hpp>
 #include <cslibs_math/common/pow.hpp>
+#include <eigen3/Eigen/Core>
+#include <limits>
+#include <type_traits>
 
 namespace cslibs_math {
 namespace approx {
@@ -27,6 +33,121 @@ inline constexpr T exp(const T value) {
   return detail::square<Accuracy_T, T>::eval(
       T{1.0} + value / common::pow2<Accuracy_T, T>());
 }
+
+namespace detail {
+/**
+ * @brief Range reduction constants, ln(2) is split Cody-Waite style, so
+ *        n * ln2_hi is exact.
+ */
+template <typename T>
+struct ExpConstants;
+
+template <>
+struct ExpConstants<float> {
+  static constexpr float log2e = 1.44269504088896341f;
+  static constexpr float ln2_hi = 0.693359375f;
+  static constexpr float ln2_lo = -2.12194440e-4f;
+  static constexpr float min = -87.3365447505531f;
+  static constexpr float max = 88.3762626647949f;
+};
+
+template <>
+struct ExpConstants<double> {
+  static constexpr double log2e = 1.44269504088896341;
+  static constexpr double ln2_hi = 0.693145751953125;
+  static constexpr double ln2_lo = 1.42860682030941723212e-6;
+  static constexpr double min = -708.396418532264;
+  static constexpr double max = 709.436139303103;
+};
+
+template <typename Packet, typename = void>
+struct HasIntegerPacket : std::false_type {};
+
+template <typename Packet>
+struct HasIntegerPacket<
+    Packet, std::void_t<typename Eigen::internal::unpacket_traits<
+                Packet>::integer_packet>> : std::true_type {};
+
+/**
+ * @brief exp(x) = 2^n * exp(r), n = round(x / ln(2)), r = x - n * ln(2)
+ *        written with Eigen's packet math, so the same code serves SIMD
+ *        packets and plain scalars. Inputs below the smallest normal
+ *        result yield zero, large ones are clamped to 2^127.5 (float) or
+ *        2^1023.5 (double).
+ */
+template <typename T, ExpAccuracy Accuracy>
+struct ExpKernel {
+  using packet_t = typename Eigen::internal::packet_traits<T>::type;
+  using constants_t = ExpConstants<T>;
+  using polynomial_t = ExpPolynomial<T, Accuracy>;
+
+  static constexpr std::size_t packet_size = static_cast<std::size_t>(
+      Eigen::internal::unpacket_traits<packet_t>::size);
+
+  template <typename Packet>
+  inline static Packet eval(const Packet &x) {
+    using namespace Eigen::internal;
+    const Packet clamped = pmin(pmax(x, pset1<Packet>(constants_t::min)),
+                                pset1<Packet>(constants_t::max));
+    const Packet n = print(pmul(clamped, pset1<Packet>(constants_t::log2e)));
+    Packet r = psub(clamped, pmul(n, pset1<Packet>(constants_t::ln2_hi)));
+    /// keeps -ffast-math from folding ln2_hi + ln2_lo again
+    EIGEN_OPTIMIZATION_BARRIER(r);
+    r = psub(r, pmul(n, pset1<Packet>(constants_t::ln2_lo)));
+
+    Packet p = pset1<Packet>(polynomial_t::coefficients[polynomial_t::degree]);
+    for (std::size_t i = polynomial_t::degree; i > 0; --i)
+      p = pmadd(p, r, pset1<Packet>(polynomial_t::coefficients[i - 1]));
+
+    return pselect(pcmp_lt(x, pset1<Packet>(constants_t::min)), pzero(x),
+                   ldexp(p, n));
+  }
+
+ private:
+  /// the clamped range keeps 2^n normal, so the exponent bits can be set
+  /// directly where the packet has an integer counterpart
+  template <typename Packet>
+  inline static Packet ldexp(const Packet &p, const Packet &n) {
+    if constexpr (HasIntegerPacket<Packet>::value)
+      return Eigen::internal::pldexp_fast_impl<Packet>::run(p, n);
+    else
+      return Eigen::internal::pldexp(p, n);
+  }
+
+  inline static T ldexp(const T p, const T n) {
+    return std::ldexp(p, static_cast<int>(n));
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief Polynomial exp of a single value, see ExpAccuracy. The maximum
+ *        relative errors are the ones of ExpPolynomial: 7.5e-5 (Coarse),
+ *        1.4e-7 / 7.5e-8 (Fine, float / double) and 1.8e-8 / 2.3e-17
+ *        (Full) plus the rounding of the evaluation.
+ */
+template <ExpAccuracy Accuracy, typename T>
+inline T exp(const T value) {
+  return detail::ExpKernel<T, Accuracy>::eval(value);
+}
+
+/**
+ * @brief Bulk polynomial exp, out[i] = exp(in[i]) for i < n. Full packets
+ *        are processed with SIMD, the remainder one by one. in and out may
+ *        be the same array, no alignment is required.
+ */
+template <ExpAccuracy Accuracy = ExpAccuracy::Full, typename T>
+inline void exp(const T *in, T *out, const std::size_t n) {
+  using kernel_t = detail::ExpKernel<T, Accuracy>;
+  using packet_t = typename kernel_t::packet_t;
+
+  std::size_t i = 0;
+  for (; i + kernel_t::packet_size <= n; i += kernel_t::packet_size) {
+    Eigen::internal::pstoreu(
+        out + i, kernel_t::eval(Eigen::internal::ploadu<packet_t>(in + i)));
+  }
+  for (; i < n; ++i) out[i] = kernel_t::eval(in[i]);
+}
 }  // namespace approx
 }  // namespace cslibs_math
 
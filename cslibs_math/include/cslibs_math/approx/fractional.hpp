@@ -2,6 +2,7 @@
 #define CSLIBS_MATH_FRACTIONAL_HPP
 
 #include <cmath>
+#include <eigen3/Eigen/Core>
 #include <limits>
 #include <type_traits>
 
@@ -26,6 +27,16 @@ class Fractional {
 
   inline int exponent() const { return exponent_; }
 
+  /**
+   * @brief The same value with the fraction in [0.5, 1), like the value
+   *        constructor yields it, sums and differences are not normalized.
+   */
+  inline Fractional normalized() const {
+    int exponent;
+    const T fraction = std::frexp(fraction_, &exponent);
+    return Fractional(fraction, fraction == T() ? 0 : exponent_ + exponent);
+  }
+
  private:
   int exponent_{0};
   T fraction_{0};
@@ -34,17 +45,26 @@ class Fractional {
 }  // namespace cslibs_math
 
 template <typename T>
-inline cslibs_math::approx::Fractional<T> operator == (
-    const cslibs_math::approx::Fractional<T> &a,
-    const cslibs_math::approx::Fractional<T> &b) {
-  return a.fraction() == b.fraction() && a.exponent() == b.exponent();
+inline bool operator==(const cslibs_math::approx::Fractional<T> &a,
+                       const cslibs_math::approx::Fractional<T> &b) {
+  const auto na = a.normalized();
+  const auto nb = b.normalized();
+  return na.fraction() == nb.fraction() && na.exponent() == nb.exponent();
 }
 
 template <typename T>
-inline cslibs_math::approx::Fractional<T> operator < (
-    const cslibs_math::approx::Fractional<T> &a,
-    const cslibs_math::approx::Fractional<T> &b) {
-  return a.fraction() < b.fraction() && a.exponent() <= b.exponent();
+inline bool operator<(const cslibs_math::approx::Fractional<T> &a,
+                      const cslibs_math::approx::Fractional<T> &b) {
+  const auto na = a.normalized();
+  const auto nb = b.normalized();
+  /// normalized fractions of equal sign share the order of their exponents,
+  /// mirrored for negative values
+  const bool negative = na.fraction() < T(0);
+  if (negative != (nb.fraction() < T(0)) || na.fraction() == T(0) ||
+      nb.fraction() == T(0) || na.exponent() == nb.exponent())
+    return na.fraction() < nb.fraction();
+  return negative ? na.exponent() > nb.exponent()
+                  : na.exponent() < nb.exponent();
 }
 
 template <typename T>
@@ -85,4 +105,143 @@ inline cslibs_math::approx::Fractional<T> operator-(
                                             b.exponent());
 }
 
+namespace cslibs_math {
+namespace approx {
+/**
+ * @brief FractionalProduct multiplies long sequences of factors, e.g. the
+ *        beam likelihoods of a particle, without underflow. Instead of
+ *        calling frexp and ldexp per factor like Fractional, the running
+ *        products are plain mantissas which are renormalized only every
+ *        renormalization_interval multiplications by extracting their
+ *        exponents. Arrays are multiplied in SIMD lanes, which are merged
+ *        into one Fractional when the product is read.
+ *        The product of renormalization_interval factors has to stay a normal
+ *        number, with the default interval of 8 the factors have to be above
+ *        2^-15 (float) or 2^-127 (double). Factors of 0 yield 0.
+ */
+template <typename T, std::size_t renormalization_interval = 8>
+class EIGEN_ALIGN16 FractionalProduct {
+ public:
+  static_assert(std::is_floating_point<T>::value,
+                "Type must be floating point.");
+  static_assert(renormalization_interval > 0,
+                "Renormalization interval must be positive.");
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  using allocator_t = Eigen::aligned_allocator<
+      FractionalProduct<T, renormalization_interval>>;
+  using packet_t = typename Eigen::internal::packet_traits<T>::type;
+
+  static constexpr std::size_t packet_size = static_cast<std::size_t>(
+      Eigen::internal::unpacket_traits<packet_t>::size);
+
+  inline FractionalProduct() { reset(); }
+
+  inline void reset() {
+    for (std::size_t c = 0; c < CHAINS; ++c) {
+      mantissas_[c] = Eigen::internal::pset1<packet_t>(T(1));
+      exponents_[c] = Eigen::internal::pset1<packet_t>(T(0));
+    }
+    packets_pending_ = 0;
+    mantissa_ = T(1);
+    exponent_ = 0;
+    pending_ = 0;
+  }
+
+  inline void multiply(const T factor) {
+    mantissa_ *= factor;
+    if (++pending_ == renormalization_interval) {
+      int exponent;
+      mantissa_ = std::frexp(mantissa_, &exponent);
+      exponent_ += exponent;
+      pending_ = 0;
+    }
+  }
+
+  /**
+   * @brief Multiply factors[0, n), blocks of full packets are multiplied
+   *        into the SIMD lanes, the remainder one by one. No alignment is
+   *        required.
+   */
+  inline void multiply(const T *factors, const std::size_t n) {
+    using namespace Eigen::internal;
+    std::size_t i = 0;
+    for (; i + CHAINS * packet_size <= n; i += CHAINS * packet_size) {
+      for (std::size_t c = 0; c < CHAINS; ++c) {
+        mantissas_[c] = pmul(mantissas_[c],
+                             ploadu<packet_t>(factors + i + c * packet_size));
+      }
+      if (++packets_pending_ == renormalization_interval) renormalize();
+    }
+    for (; i < n; ++i) multiply(factors[i]);
+  }
+
+  inline FractionalProduct &operator*=(const T factor) {
+    multiply(factor);
+    return *this;
+  }
+
+  /**
+   * @brief The product of all factors, the lanes merged.
+   */
+  inline Fractional<T> get() const {
+    using namespace Eigen::internal;
+    T lane_mantissas[CHAINS * packet_size];
+    T lane_exponents[CHAINS * packet_size];
+    for (std::size_t c = 0; c < CHAINS; ++c) {
+      packet_t exponents;
+      const packet_t mantissas = pfrexp(mantissas_[c], exponents);
+      pstoreu(lane_mantissas + c * packet_size, mantissas);
+      pstoreu(lane_exponents + c * packet_size, padd(exponents, exponents_[c]));
+    }
+
+    int exponent;
+    T mantissa = std::frexp(mantissa_, &exponent);
+    exponent += exponent_;
+    for (std::size_t l = 0; l < CHAINS * packet_size; ++l) {
+      /// both factors are in [0.5, 1), their product cannot underflow
+      int e;
+      mantissa = std::frexp(mantissa * lane_mantissas[l], &e);
+      exponent += e + static_cast<int>(lane_exponents[l]);
+    }
+    return mantissa == T(0) ? Fractional<T>()
+                            : Fractional<T>(mantissa, exponent);
+  }
+
+  inline T value() const { return get().value(); }
+
+  /**
+   * @brief Natural logarithm of the product, which stays representable
+   *        where the value underflows.
+   */
+  inline T log() const {
+    const Fractional<T> product = get();
+    return std::log(product.fraction()) +
+           static_cast<T>(product.exponent()) * static_cast<T>(M_LN2);
+  }
+
+ private:
+  /// independent multiplication chains hide the latency of pmul
+  static constexpr std::size_t CHAINS = 2;
+
+  packet_t mantissas_[CHAINS];
+  packet_t exponents_[CHAINS];
+  std::size_t packets_pending_;
+  T mantissa_;
+  int exponent_;
+  std::size_t pending_;
+
+  inline void renormalize() {
+    using namespace Eigen::internal;
+    for (std::size_t c = 0; c < CHAINS; ++c) {
+      packet_t exponents;
+      mantissas_[c] = pfrexp(mantissas_[c], exponents);
+      exponents_[c] = padd(exponents_[c], exponents);
+    }
+    packets_pending_ = 0;
+  }
+};
+}  // namespace approx
+}  // namespace cslibs_math
+
 #endif  // CSLIBS_MATH_FRACTIONAL_HPP
\ No newline at end of file
@@ -1,9 +1,16 @@
 #ifndef CSLIBS_MATH_LOG_HPP
 #define CSLIBS_MATH_LOG_HPP
 
+#include <algorithm>
 #include <cmath>
+#include <cslibs_math/approx/exp.hpp>
+#include <cstdint>
+#include <cstring>
+#include <eigen3/Eigen/Core>
 #include <limits>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 namespace cslibs_math {
 namespace approx {
@@ -31,6 +38,104 @@ struct BaseE {
   inline static T log1p(const T value) { return std::log1p(value); }
   inline static T log1m(const T value) { return std::log(1.0 - value); }
 };
+
+/**
+ * @brief IEEE 754 layout used to split values into exponent and mantissa.
+ */
+template <typename T>
+struct FloatBits;
+
+template <>
+struct FloatBits<float> {
+  using type = std::uint32_t;
+  static constexpr int mantissa_bits = 23;
+  static constexpr type exponent_mask = 0xff;
+  static constexpr int bias = 127;
+};
+
+template <>
+struct FloatBits<double> {
+  using type = std::uint64_t;
+  static constexpr int mantissa_bits = 52;
+  static constexpr type exponent_mask = 0x7ff;
+  static constexpr int bias = 1023;
+};
+
+/**
+ * @brief Natural logarithm by exponent extraction and a polynomial for the
+ *        mantissa: value = m * 2^e with m in [sqrt(1/2), sqrt(2)), then
+ *        ln(m) = 2 atanh(s) = 2 s p(s^2) with s = (m - 1) / (m + 1),
+ *        |s| <= 0.1716 and the minimax polynomial p = LogPolynomial.
+ *        Maximum absolute error, relative for |ln(value)| > 1:
+ *        Coarse - 8e-6, degree 1
+ *        Fine   - 4.2e-8, degree 2
+ *        Full   - machine precision, degree 3 for float, 7 for double
+ *        Non-positive values yield -inf.
+ */
+template <typename T, ExpAccuracy Accuracy>
+struct FastLog {
+  using polynomial_t = LogPolynomial<T, Accuracy>;
+
+  /// written without branches, so loops over it can be vectorized
+  inline static T eval(const T value) {
+    using bits_t = FloatBits<T>;
+    using int_t = typename bits_t::type;
+    /// denormals are scaled into the normal range first
+    const bool denormal = value < std::numeric_limits<T>::min();
+    const T scaled =
+        denormal ? value * static_cast<T>(int_t(1) << bits_t::mantissa_bits)
+                 : value;
+
+    int_t bits;
+    std::memcpy(&bits, &scaled, sizeof(T));
+    const int_t exponent_bits =
+        (bits >> bits_t::mantissa_bits) & bits_t::exponent_mask;
+    bits = (bits & ((int_t(1) << bits_t::mantissa_bits) - 1)) |
+           (static_cast<int_t>(bits_t::bias) << bits_t::mantissa_bits);
+    T m;
+    std::memcpy(&m, &bits, sizeof(T));
+    const bool upper = m > static_cast<T>(M_SQRT2);
+    m = upper ? m * T(0.5) : m;
+    const T exponent =
+        static_cast<T>(static_cast<std::int32_t>(exponent_bits)) -
+        static_cast<T>(bits_t::bias) + (upper ? T(1) : T(0)) -
+        (denormal ? static_cast<T>(bits_t::mantissa_bits) : T(0));
+
+    const T s = (m - T(1)) / (m + T(1));
+    const T s2 = s * s;
+    T p = polynomial_t::coefficients[polynomial_t::degree];
+    for (std::size_t i = polynomial_t::degree; i > 0; --i)
+      p = p * s2 + polynomial_t::coefficients[i - 1];
+    const T result = T(2) * s * p + exponent * static_cast<T>(M_LN2);
+    return value > T() ? result : -std::numeric_limits<T>::infinity();
+  }
+};
+
+/**
+ * @brief Base policies with the approximate kernels: FastLog and the
+ *        polynomial exp of the given accuracy tier.
+ */
+template <typename T, ExpAccuracy Accuracy = ExpAccuracy::Fine>
+struct FastBase2 {
+  inline static T log(const T value) {
+    return FastLog<T, Accuracy>::eval(value) * static_cast<T>(M_LOG2E);
+  }
+  inline static T exp(const T log) {
+    return approx::exp<Accuracy>(log * static_cast<T>(M_LN2));
+  }
+  inline static T log1p(const T value) { return log(T(1) + value); }
+  inline static T log1m(const T value) { return log(T(1) - value); }
+};
+
+template <typename T, ExpAccuracy Accuracy = ExpAccuracy::Fine>
+struct FastBaseE {
+  inline static T log(const T value) {
+    return FastLog<T, Accuracy>::eval(value);
+  }
+  inline static T exp(const T log) { return approx::exp<Accuracy>(log); }
+  inline static T log1p(const T value) { return log(T(1) + value); }
+  inline static T log1m(const T value) { return log(T(1) - value); }
+};
 }  // namespace detail
 
 template <typename T, typename Base_T = detail::Base2<T>>
@@ -88,13 +193,20 @@ class Log {
   }
 
   inline Log operator+(const Log log) const {
-    Log l;
-    l.value_ = value_ + Base_T::log1p(Base_T::exp(log.value_ - value_));
+    Log l(*this);
+    l += log;
     return l;
   }
 
+  /// the larger value is factored out, so exp cannot overflow
   inline Log& operator+=(const Log log) {
-    value_ += Base_T::log1p(Base_T::exp(log.value_ - value_));
+    const T max = std::max(value_, log.value_);
+    const T min = std::min(value_, log.value_);
+    if (min <= std::numeric_limits<T>::lowest()) {
+      value_ = max;
+      return *this;
+    }
+    value_ = max + Base_T::log1p(Base_T::exp(min - max));
     return *this;
   }
 
@@ -113,7 +225,7 @@ class Log {
       return !std::isinf(value_);
   }
 
-  inline T value() const { return value(); }
+  inline T value() const { return value_; }
 
   inline T exp() const { return Base_T::exp(value_); }
 
@@ -123,6 +235,249 @@ class Log {
   T value_{-std::numeric_limits<T>::infinity()};
 };
 
+namespace detail {
+/**
+ * @brief Maximum of values[0, n) and the sum of exp(values[i] - max),
+ *        exponentiated with the polynomial exp kernel in SIMD packets. The
+ *        sum is left 0 if all values are -inf.
+ */
+template <ExpAccuracy Accuracy, typename T>
+inline void shiftedSumExp(const T *values, const std::size_t n, T &max,
+                          T &sum) {
+  using namespace Eigen::internal;
+  using kernel_t = ExpKernel<T, Accuracy>;
+  using packet_t = typename kernel_t::packet_t;
+  sum = T();
+  max = n == 0 ? -std::numeric_limits<T>::infinity()
+               : Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>(
+                     values, static_cast<Eigen::Index>(n))
+                     .maxCoeff();
+  if (max <= std::numeric_limits<T>::lowest()) return;
+
+  const packet_t shift = pset1<packet_t>(max);
+  packet_t sums = pset1<packet_t>(T());
+  std::size_t i = 0;
+  for (; i + kernel_t::packet_size <= n; i += kernel_t::packet_size)
+    sums = padd(sums,
+                kernel_t::eval(psub(ploadu<packet_t>(values + i), shift)));
+  sum = predux(sums);
+  for (; i < n; ++i) sum += kernel_t::eval(values[i] - max);
+}
+
+/**
+ * @brief Write exp(values[i] - shift) to out[i] for i < n.
+ * @return the sum of the written values
+ */
+template <ExpAccuracy Accuracy, typename T>
+inline T shiftedExp(const T *values, T *out, const std::size_t n,
+                    const T shift) {
+  using namespace Eigen::internal;
+  using kernel_t = ExpKernel<T, Accuracy>;
+  using packet_t = typename kernel_t::packet_t;
+  const packet_t s = pset1<packet_t>(shift);
+  packet_t sums = pset1<packet_t>(T());
+  std::size_t i = 0;
+  for (; i + kernel_t::packet_size <= n; i += kernel_t::packet_size) {
+    const packet_t e = kernel_t::eval(psub(ploadu<packet_t>(values + i), s));
+    pstoreu(out + i, e);
+    sums = padd(sums, e);
+  }
+  T sum = predux(sums);
+  for (; i < n; ++i) sum += out[i] = kernel_t::eval(values[i] - shift);
+  return sum;
+}
+
+/// smallest number of values a thread is started for
+constexpr std::size_t PARALLEL_CHUNK_SIZE = 16384;
+
+/**
+ * @brief Split [0, n) into contiguous chunks and call fn(chunk, begin, end)
+ *        for each of them, chunk 0 on the calling thread. The chunks only
+ *        depend on n and the number of threads.
+ * @return the number of chunks
+ */
+template <typename Function>
+inline std::size_t forEachChunk(const std::size_t n, std::size_t threads,
+                                Function fn) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t chunks = std::max<std::size_t>(
+      1, std::min(threads, n / PARALLEL_CHUNK_SIZE));
+
+  std::vector<std::thread> workers;
+  workers.reserve(chunks - 1);
+  for (std::size_t c = 1; c < chunks; ++c)
+    workers.emplace_back(fn, c, c * n / chunks, (c + 1) * n / chunks);
+  fn(0, std::size_t(0), n / chunks);
+  for (std::thread &w : workers) w.join();
+  return chunks;
+}
+
+/**
+ * @brief Per-chunk shifted sums combined into the log-sum-exp of all values.
+ */
+template <ExpAccuracy Accuracy, typename T>
+inline T parallelLogSumExp(const T *values, const std::size_t n,
+                           const std::size_t threads) {
+  std::vector<T> maxima(std::max<std::size_t>(threads, 1));
+  std::vector<T> sums(maxima.size());
+  const std::size_t chunks = forEachChunk(
+      n, maxima.size(),
+      [values, &maxima, &sums](const std::size_t c, const std::size_t begin,
+                               const std::size_t end) {
+        shiftedSumExp<Accuracy>(values + begin, end - begin, maxima[c],
+                                sums[c]);
+      });
+
+  const T max = *std::max_element(maxima.begin(), maxima.begin() + chunks);
+  if (max <= std::numeric_limits<T>::lowest()) return max;
+  T sum = T();
+  for (std::size_t c = 0; c < chunks; ++c)
+    sum += sums[c] * std::exp(maxima[c] - max);
+  return max + std::log(sum);
+}
+}  // namespace detail
+
+/**
+ * @brief Natural logarithm of the sum of exp(values[i]) for i < n, e.g. the
+ *        normalizer of particle log-weights. Two passes: the maximum is
+ *        found first and factored out, then the shifted values are
+ *        exponentiated with the polynomial exp kernel and summed in SIMD
+ *        packets. Yields -inf for empty input or if all values are -inf.
+ */
+template <ExpAccuracy Accuracy = ExpAccuracy::Full, typename T>
+inline T logSumExp(const T *values, const std::size_t n) {
+  T max;
+  T sum;
+  detail::shiftedSumExp<Accuracy>(values, n, max, sum);
+  return sum > T() ? max + std::log(sum) : max;
+}
+
+/**
+ * @brief Parallel logSumExp for large sample sets, e.g. more than 100k
+ *        particles. Each thread reduces a contiguous chunk of at least
+ *        detail::PARALLEL_CHUNK_SIZE values, the chunk results are combined
+ *        in a fixed order, so the result only depends on the thread count.
+ * @param threads - number of threads, 0 uses the hardware concurrency
+ */
+template <ExpAccuracy Accuracy = ExpAccuracy::Full, typename T>
+inline T logSumExp(const T *values, const std::size_t n,
+                   const std::size_t threads) {
+  return detail::parallelLogSumExp<Accuracy>(
+      values, n,
+      threads == 0 ? std::max(1u, std::thread::hardware_concurrency())
+                   : threads);
+}
+
+/**
+ * @brief Normalize log-weights in place, so that their exponentials sum up
+ *        to one. Weights stay untouched if all of them are -inf.
+ * @return the log-sum-exp of the weights before normalization
+ */
+template <ExpAccuracy Accuracy = ExpAccuracy::Full, typename T>
+inline T normalizeLogWeights(T *log_weights, const std::size_t n) {
+  const T normalizer = logSumExp<Accuracy>(log_weights, n);
+  if (normalizer <= std::numeric_limits<T>::lowest()) return normalizer;
+  Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>>(
+      log_weights, static_cast<Eigen::Index>(n)) -= normalizer;
+  return normalizer;
+}
+
+/**
+ * @brief Parallel normalizeLogWeights for large sample sets.
+ * @param threads - number of threads, 0 uses the hardware concurrency
+ */
+template <ExpAccuracy Accuracy = ExpAccuracy::Full, typename T>
+inline T normalizeLogWeights(T *log_weights, const std::size_t n,
+                             const std::size_t threads) {
+  const T normalizer = logSumExp<Accuracy>(log_weights, n, threads);
+  if (normalizer <= std::numeric_limits<T>::lowest()) return normalizer;
+  detail::forEachChunk(
+      n, threads,
+      [log_weights, normalizer](const std::size_t, const std::size_t begin,
+                                const std::size_t end) {
+        Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>>(
+            log_weights + begin, static_cast<Eigen::Index>(end - begin)) -=
+            normalizer;
+      });
+  return normalizer;
+}
+
+/**
+ * @brief Normalized linear weights from log-weights, weights[i] =
+ *        exp(log_weights[i] - logSumExp(log_weights)), e.g. for resampling.
+ *        The shifted exponentials are stored while they are summed and
+ *        scaled afterwards, so exp is evaluated once per weight.
+ *        All weights are set to 0 if all log-weights are -inf.
+ * @return the log-sum-exp of the log-weights
+ */
+template <ExpAccuracy Accuracy = ExpAccuracy::Full, typename T>
+inline T normalizeLogWeights(const T *log_weights, T *weights,
+                             const std::size_t n) {
+  Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>> w(
+      weights, static_cast<Eigen::Index>(n));
+  const T max = n == 0 ? -std::numeric_limits<T>::infinity()
+                       : Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>(
+                             log_weights, static_cast<Eigen::Index>(n))
+                             .maxCoeff();
+  if (max <= std::numeric_limits<T>::lowest()) {
+    w.setZero();
+    return max;
+  }
+  const T sum = detail::shiftedExp<Accuracy>(log_weights, weights, n, max);
+  w *= T(1) / sum;
+  return max + std::log(sum);
+}
+
+/**
+ * @brief Parallel normalized linear weights for large sample sets, the
+ *        maximum, the shifted exponentials and the scaling are computed in
+ *        three parallel passes.
+ * @param threads - number of threads, 0 uses the hardware concurrency
+ */
+template <ExpAccuracy Accuracy = ExpAccuracy::Full, typename T>
+inline T normalizeLogWeights(const T *log_weights, T *weights,
+                             const std::size_t n, std::size_t threads) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<T> partial(threads);
+  const std::size_t chunks = detail::forEachChunk(
+      n, threads,
+      [log_weights, &partial](const std::size_t c, const std::size_t begin,
+                              const std::size_t end) {
+        partial[c] = begin == end
+                         ? -std::numeric_limits<T>::infinity()
+                         : *std::max_element(log_weights + begin,
+                                             log_weights + end);
+      });
+  const T max = *std::max_element(partial.begin(), partial.begin() + chunks);
+  if (max <= std::numeric_limits<T>::lowest()) {
+    std::fill(weights, weights + n, T());
+    return max;
+  }
+
+  detail::forEachChunk(
+      n, threads,
+      [log_weights, weights, max, &partial](const std::size_t c,
+                                            const std::size_t begin,
+                                            const std::size_t end) {
+        partial[c] = detail::shiftedExp<Accuracy>(
+            log_weights + begin, weights + begin, end - begin, max);
+      });
+  T sum = T();
+  for (std::size_t c = 0; c < chunks; ++c) sum += partial[c];
+
+  const T scale = T(1) / sum;
+  detail::forEachChunk(
+      n, threads,
+      [weights, scale](const std::size_t, const std::size_t begin,
+                       const std::size_t end) {
+        Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>>(
+            weights + begin, static_cast<Eigen::Index>(end - begin)) *= scale;
+      });
+  return max + std::log(sum);
+}
+
 // https://en.wikipedia.org/wiki/List_of_logarithmic_identities
 // https://en.wikipedia.org/wiki/Log_probability
 /* log(x + y) = log(x + x * y/x)
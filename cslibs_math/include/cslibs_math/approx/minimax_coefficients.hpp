@@ -0,0 +1,261 @@
+// Generated by scripts/minimax.py, do not edit. Regenerate with the
+// cslibs_math_minimax_coefficients target.
+#ifndef CSLIBS_MATH_MINIMAX_COEFFICIENTS_HPP
+#define CSLIBS_MATH_MINIMAX_COEFFICIENTS_HPP
+
+#include <cslibs_math/approx/accuracy.hpp>
+#include <cstddef>
+
+namespace cslibs_math {
+namespace approx {
+namespace detail {
+/**
+ * @brief Minimax polynomials p(r) ~ exp(r) for |r| <= ln(2) / 2.
+ *        The coefficients are in increasing order, error is the maximum
+ *        relative error of p with the rounded coefficients.
+ */
+template <typename T, ExpAccuracy Accuracy>
+struct ExpPolynomial;
+
+template <>
+struct ExpPolynomial<float, ExpAccuracy::Coarse> {
+  static constexpr float error = 7.5e-05f;
+  static constexpr std::size_t degree = 3;
+  static constexpr float coefficients[degree + 1] = {
+      0.999928057f,
+      1.00016415f,
+      0.504963279f,
+      0.165668428f};
+};
+
+template <>
+struct ExpPolynomial<float, ExpAccuracy::Fine> {
+  static constexpr float error = 1.4e-07f;
+  static constexpr std::size_t degree = 5;
+  static constexpr float coefficients[degree + 1] = {
+      1.00000012f,
+      0.999999702f,
+      0.499988943f,
+      0.166675746f,
+      0.0419153832f,
+      0.0082976548f};
+};
+
+template <>
+struct ExpPolynomial<float, ExpAccuracy::Full> {
+  static constexpr float error = 1.8e-08f;
+  static constexpr std::size_t degree = 6;
+  static constexpr float coefficients[degree + 1] = {
+      1.0f,
+      1.0f,
+      0.499999911f,
+      0.166664198f,
+      0.0416682251f,
+      0.00837481581f,
+      0.00138368458f};
+};
+
+template <>
+struct ExpPolynomial<double, ExpAccuracy::Coarse> {
+  static constexpr double error = 7.5e-05;
+  static constexpr std::size_t degree = 3;
+  static constexpr double coefficients[degree + 1] = {
+      0.9999280735393948,
+      1.0001641857658372,
+      0.504963264179929,
+      0.16566842342912572};
+};
+
+template <>
+struct ExpPolynomial<double, ExpAccuracy::Fine> {
+  static constexpr double error = 7.5e-08;
+  static constexpr std::size_t degree = 5;
+  static constexpr double coefficients[degree + 1] = {
+      1.0000000716546849,
+      0.999999691991555,
+      0.49998894851203973,
+      0.16667574728622156,
+      0.04191538199275374,
+      0.008297655088534838};
+};
+
+template <>
+struct ExpPolynomial<double, ExpAccuracy::Full> {
+  static constexpr double error = 2.3e-17;
+  static constexpr std::size_t degree = 11;
+  static constexpr double coefficients[degree + 1] = {
+      1.0,
+      1.0,
+      0.5000000000000018,
+      0.1666666666666617,
+      0.04166666666649277,
+      0.008333333333559272,
+      0.0013888888951224037,
+      0.0001984126943267626,
+      2.4801486521375963e-05,
+      2.7557622533559636e-06,
+      2.763229329749692e-07,
+      2.49943040159891e-08};
+};
+
+/**
+ * @brief Minimax polynomials p(z) ~ atanh(s) / s with z = s^2 for
+ *        |s| <= 3 - 2 sqrt(2), so ln(m) = 2 s p(s^2) for m in
+ *        [sqrt(1/2), sqrt(2)] and s = (m - 1) / (m + 1).
+ *        The coefficients are in increasing order, error is the maximum
+ *        relative error of p with the rounded coefficients.
+ */
+template <typename T, ExpAccuracy Accuracy>
+struct LogPolynomial;
+
+template <>
+struct LogPolynomial<float, ExpAccuracy::Coarse> {
+  static constexpr float error = 2.3e-05f;
+  static constexpr std::size_t degree = 1;
+  static constexpr float coefficients[degree + 1] = {
+      0.999977767f,
+      0.339339942f};
+};
+
+template <>
+struct LogPolynomial<float, ExpAccuracy::Fine> {
+  static constexpr float error = 1.2e-07f;
+  static constexpr std::size_t degree = 2;
+  static constexpr float coefficients[degree + 1] = {
+      1.00000012f,
+      0.333261132f,
+      0.206481859f};
+};
+
+template <>
+struct LogPolynomial<float, ExpAccuracy::Full> {
+  static constexpr float error = 1.6e-09f;
+  static constexpr std::size_t degree = 3;
+  static constexpr float coefficients[degree + 1] = {
+      1.0f,
+      0.333334088f,
+      0.199873969f,
+      0.149628252f};
+};
+
+template <>
+struct LogPolynomial<double, ExpAccuracy::Coarse> {
+  static constexpr double error = 2.3e-05;
+  static constexpr std::size_t degree = 1;
+  static constexpr double coefficients[degree + 1] = {
+      0.9999777446767659,
+      0.3393399287932016};
+};
+
+template <>
+struct LogPolynomial<double, ExpAccuracy::Fine> {
+  static constexpr double error = 1.2e-07;
+  static constexpr std::size_t degree = 2;
+  static constexpr double coefficients[degree + 1] = {
+      1.0000001186870144,
+      0.3332611185005319,
+      0.20648186432576543};
+};
+
+template <>
+struct LogPolynomial<double, ExpAccuracy::Full> {
+  static constexpr double error = 2.3e-18;
+  static constexpr std::size_t degree = 7;
+  static constexpr double coefficients[degree + 1] = {
+      1.0,
+      0.33333333333333826,
+      0.1999999999964944,
+      0.14285714380673384,
+      0.11111098494120161,
+      0.09091817547251331,
+      0.07656221876505609,
+      0.07405264921553491};
+};
+
+/**
+ * @brief Minimax polynomials p(z) ~ atan(u) / u with z = u^2 for
+ *        |u| <= tan(pi / 8), so atan(u) = u p(u^2).
+ *        The coefficients are in increasing order, error is the maximum
+ *        relative error of p with the rounded coefficients.
+ */
+template <typename T, ExpAccuracy Accuracy>
+struct AtanPolynomial;
+
+template <>
+struct AtanPolynomial<float, ExpAccuracy::Coarse> {
+  static constexpr float error = 1.9e-05f;
+  static constexpr std::size_t degree = 2;
+  static constexpr float coefficients[degree + 1] = {
+      0.999981999f,
+      -0.331390679f,
+      0.168229312f};
+};
+
+template <>
+struct AtanPolynomial<float, ExpAccuracy::Fine> {
+  static constexpr float error = 4.0e-08f;
+  static constexpr std::size_t degree = 4;
+  static constexpr float coefficients[degree + 1] = {
+      1.0f,
+      -0.333327979f,
+      0.199744701f,
+      -0.138520882f,
+      0.0798673704f};
+};
+
+template <>
+struct AtanPolynomial<float, ExpAccuracy::Full> {
+  static constexpr float error = 4.0e-08f;
+  static constexpr std::size_t degree = 4;
+  static constexpr float coefficients[degree + 1] = {
+      1.0f,
+      -0.333327979f,
+      0.199744701f,
+      -0.138520882f,
+      0.0798673704f};
+};
+
+template <>
+struct AtanPolynomial<double, ExpAccuracy::Coarse> {
+  static constexpr double error = 1.9e-05;
+  static constexpr std::size_t degree = 2;
+  static constexpr double coefficients[degree + 1] = {
+      0.9999819779326417,
+      -0.33139067904104336,
+      0.1682293151134026};
+};
+
+template <>
+struct AtanPolynomial<double, ExpAccuracy::Fine> {
+  static constexpr double error = 1.9e-08;
+  static constexpr std::size_t degree = 4;
+  static constexpr double coefficients[degree + 1] = {
+      0.9999999819945108,
+      -0.33332799194754953,
+      0.19974470362721566,
+      -0.13852088291066306,
+      0.07986736726981238};
+};
+
+template <>
+struct AtanPolynomial<double, ExpAccuracy::Full> {
+  static constexpr double error = 6.7e-17;
+  static constexpr std::size_t degree = 10;
+  static constexpr double coefficients[degree + 1] = {
+      1.0,
+      -0.3333333333332862,
+      0.19999999998889212,
+      -0.1428571418350976,
+      0.11111106276082061,
+      -0.09090775149157856,
+      0.07689980900759853,
+      -0.0664045807573874,
+      0.05689457405639291,
+      -0.04351086196842449,
+      0.021170682474998127};
+};
+}  // namespace detail
+}  // namespace approx
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_MINIMAX_COEFFICIENTS_HPP
@@ -8,7 +8,7 @@ namespace approx {
 template <typename T>
 constexpr T sqrtNewtonRaphson(T x, T curr, T prev) {
   return curr == prev ? curr
-                      : sqrtNewtonRaphson(x, 0.5 * (curr + x / curr), curr);
+                      : sqrtNewtonRaphson(x, T(0.5) * (curr + x / curr), curr);
 }
 
 template <typename T>
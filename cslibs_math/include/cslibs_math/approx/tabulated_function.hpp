@@ -0,0 +1,156 @@
+#ifndef CSLIBS_MATH_TABULATED_FUNCTION_HPP
+#define CSLIBS_MATH_TABULATED_FUNCTION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace cslibs_math {
+namespace approx {
+/**
+ * @brief Interpolation between the samples of a TabulatedFunction: Linear
+ *        needs two samples per lookup, Cubic (Catmull-Rom) four, but reaches
+ *        the same error with far fewer samples for smooth functions.
+ */
+enum class Interpolation { Linear, Cubic };
+
+/**
+ * @brief TabulatedFunction samples a function at N equidistant points of a
+ *        bounded domain [min, max] and evaluates it by interpolating the
+ *        table. Arguments outside the domain are clamped to it. One more
+ *        sample is taken beyond each bound for the cubic interpolation, so
+ *        the function has to be defined there.
+ *        The constructor is constexpr, so tables of constexpr functions can
+ *        be built at compile time. The error shrinks with 1 / N^2 (linear)
+ *        or 1 / N^3 (cubic), see benchmark_tabulated_function for the
+ *        errors of the Gaussian kernel.
+ */
+template <typename T, std::size_t N,
+          Interpolation interpolation = Interpolation::Linear>
+class TabulatedFunction {
+ public:
+  static_assert(std::is_floating_point<T>::value,
+                "Type must be floating point.");
+  static_assert(N > 1, "A table needs at least two samples.");
+
+  using table_t = std::array<T, N + 2>;
+
+  /**
+   * @param function - callable T(T), sampled at N points of [min, max]
+   * @param min      - lower bound of the domain
+   * @param max      - upper bound of the domain, greater than min
+   */
+  template <typename Function>
+  constexpr TabulatedFunction(const Function &function, const T min,
+                              const T max)
+      : min_{min},
+        max_{max},
+        step_{(max - min) / static_cast<T>(N - 1)},
+        inverse_step_{static_cast<T>(N - 1) / (max - min)} {
+    for (std::size_t i = 0; i < N + 2; ++i)
+      table_[i] = function(min_ + (static_cast<T>(i) - T(1)) * step_);
+  }
+
+  inline T operator()(const T x) const {
+    return evaluate(table_.data(), min_, max_, inverse_step_, x);
+  }
+
+  /**
+   * @brief Batch evaluation, out[i] = f(in[i]) for i < n. in and out may be
+   *        the same array. The members are copied to locals, so writing out
+   *        cannot alias them and they are not reloaded per element.
+   */
+  inline void operator()(const T *in, T *out, const std::size_t n) const {
+    const T *table = table_.data();
+    const T min = min_;
+    const T max = max_;
+    const T inverse_step = inverse_step_;
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = evaluate(table, min, max, inverse_step, in[i]);
+  }
+
+  constexpr T min() const { return min_; }
+
+  constexpr T max() const { return max_; }
+
+  constexpr T step() const { return step_; }
+
+  constexpr table_t const &table() const { return table_; }
+
+ private:
+  T min_;
+  T max_;
+  T step_;
+  T inverse_step_;
+  /// samples at min + (i - 1) * step
+  table_t table_{};
+
+  inline static T evaluate(const T *table, const T min, const T max,
+                           const T inverse_step, const T x) {
+    const T position = (std::min(std::max(x, min), max) - min) * inverse_step;
+    /// the last sample interpolates towards the one beyond max, the signed
+    /// conversion is a single instruction, unlike the one to std::size_t
+    const int i = std::min(static_cast<int>(position), static_cast<int>(N) - 2);
+    const T t = position - static_cast<T>(i);
+    const T *p = table + i;
+    if constexpr (interpolation == Interpolation::Linear) {
+      return p[1] + t * (p[2] - p[1]);
+    } else {
+      /// Catmull-Rom spline through p[1] and p[2]
+      const T a = T(0.5) * (-p[0] + T(3) * p[1] - T(3) * p[2] + p[3]);
+      const T b = T(0.5) * (T(2) * p[0] - T(5) * p[1] + T(4) * p[2] - p[3]);
+      const T c = T(0.5) * (p[2] - p[0]);
+      return ((a * t + b) * t + c) * t + p[1];
+    }
+  }
+};
+
+/**
+ * @brief GaussianKernel evaluates the non-normalized Gaussian
+ *        exp(-0.5 * d^2 / sigma^2) of a distance d with a TabulatedFunction
+ *        on [0, cutoff * sigma], e.g. for likelihood fields and beam models.
+ *        Distances beyond the cutoff yield the kernel value at the cutoff.
+ */
+template <typename T, std::size_t N = 1024,
+          Interpolation interpolation = Interpolation::Linear>
+class GaussianKernel {
+ public:
+  using table_t = TabulatedFunction<T, N, interpolation>;
+
+  /**
+   * @param sigma  - standard deviation
+   * @param cutoff - the domain in multiples of sigma
+   */
+  inline explicit GaussianKernel(const T sigma, const T cutoff = T(4))
+      : table_{[sigma](const T d) {
+                 return std::exp(T(-0.5) * d * d / (sigma * sigma));
+               },
+               T(0), cutoff * sigma},
+        sigma_{sigma} {}
+
+  inline T operator()(const T distance) const {
+    return table_(std::abs(distance));
+  }
+
+  /**
+   * @brief Batch evaluation, out[i] = kernel(distances[i]) for i < n.
+   */
+  inline void operator()(const T *distances, T *out,
+                         const std::size_t n) const {
+    for (std::size_t i = 0; i < n; ++i) out[i] = (*this)(distances[i]);
+  }
+
+  inline T sigma() const { return sigma_; }
+
+  inline table_t const &table() const { return table_; }
+
+ private:
+  table_t table_;
+  T sigma_;
+};
+}  // namespace approx
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_TABULATED_FUNCTION_HPP
@@ -0,0 +1,333 @@
+#ifndef CSLIBS_MATH_TRIGONOMETRIC_HPP
+#define CSLIBS_MATH_TRIGONOMETRIC_HPP
+
+#include <cmath>
+#include <cslibs_math/approx/exp.hpp>
+#include <eigen3/Eigen/Core>
+
+namespace cslibs_math {
+namespace approx {
+namespace detail {
+/**
+ * @brief Constants of the sin / cos kernel: pi/2 split into three parts for
+ *        Cody-Waite range reduction and the Cephes polynomials of sin and cos
+ *        on [-pi/4, pi/4], highest degree first.
+ */
+template <typename T>
+struct SinCosConstants;
+
+template <>
+struct SinCosConstants<float> {
+  static constexpr float two_over_pi = 0.636619772367581343f;
+  static constexpr float pi_2_hi = 1.5703125f;
+  static constexpr float pi_2_mid = 4.837512969970703125e-4f;
+  static constexpr float pi_2_lo = 7.54978995489188216e-8f;
+  static constexpr std::size_t degree = 3;
+  static constexpr float sin[degree] = {-1.9515295891e-4f, 8.3321608736e-3f,
+                                        -1.6666654611e-1f};
+  static constexpr float cos[degree] = {2.443315711809948e-5f,
+                                        -1.388731625493765e-3f,
+                                        4.166664568298827e-2f};
+};
+
+template <>
+struct SinCosConstants<double> {
+  static constexpr double two_over_pi = 0.636619772367581343;
+  static constexpr double pi_2_hi = 1.57079625129699707031;
+  static constexpr double pi_2_mid = 7.54978941586159635336e-8;
+  static constexpr double pi_2_lo = 5.39030285815811905290e-15;
+  static constexpr std::size_t degree = 6;
+  static constexpr double sin[degree] = {
+      1.58962301576546568060e-10, -2.50507477628578072866e-8,
+      2.75573136213857245213e-6,  -1.98412698295895385996e-4,
+      8.33333333332211858878e-3,  -1.66666666666666307295e-1};
+  static constexpr double cos[degree] = {
+      -1.13585365213876817300e-11, 2.08757008419747316778e-9,
+      -2.75573141792967388112e-7,  2.48015872888517045348e-5,
+      -1.38888888888730564116e-3,  4.16666666666665929218e-2};
+};
+
+/**
+ * @brief pselect(pcmp_lt(a, b), x, y). Plain scalars are compared directly
+ *        instead, their all-ones masks are NaNs, which -ffinite-math-only
+ *        does not preserve.
+ */
+template <typename Packet>
+inline Packet selectLess(const Packet &a, const Packet &b, const Packet &x,
+                         const Packet &y) {
+  return Eigen::internal::pselect(Eigen::internal::pcmp_lt(a, b), x, y);
+}
+
+inline float selectLess(const float a, const float b, const float x,
+                        const float y) {
+  return a < b ? x : y;
+}
+
+inline double selectLess(const double a, const double b, const double x,
+                         const double y) {
+  return a < b ? x : y;
+}
+
+/**
+ * @brief Horner scheme of c[0] * z^(n-1) + ... + c[n-1].
+ */
+template <typename Packet, typename T, std::size_t N>
+inline Packet horner(const Packet &z, const T (&c)[N]) {
+  using namespace Eigen::internal;
+  Packet p = pset1<Packet>(c[0]);
+  for (std::size_t i = 1; i < N; ++i) p = pmadd(p, z, pset1<Packet>(c[i]));
+  return p;
+}
+
+/**
+ * @brief sin(x) and cos(x) with x = r + j * pi/2, |r| <= pi/4. Both
+ *        polynomials are evaluated for r and swapped and negated depending
+ *        on the quadrant j mod 4, which is computed in floating point for
+ *        plain scalars and SIMD packets without integer counterpart.
+ */
+template <typename T>
+struct SinCosKernel {
+  using packet_t = typename Eigen::internal::packet_traits<T>::type;
+  using constants_t = SinCosConstants<T>;
+
+  static constexpr std::size_t packet_size = static_cast<std::size_t>(
+      Eigen::internal::unpacket_traits<packet_t>::size);
+
+  template <typename Packet>
+  inline static void eval(const Packet &x, Packet &sin, Packet &cos) {
+    using namespace Eigen::internal;
+    const Packet j = print(pmul(x, pset1<Packet>(constants_t::two_over_pi)));
+    Packet r = psub(x, pmul(j, pset1<Packet>(constants_t::pi_2_hi)));
+    /// keeps -ffast-math from folding the parts of pi/2 again
+    EIGEN_OPTIMIZATION_BARRIER(r);
+    r = psub(r, pmul(j, pset1<Packet>(constants_t::pi_2_mid)));
+    EIGEN_OPTIMIZATION_BARRIER(r);
+    r = psub(r, pmul(j, pset1<Packet>(constants_t::pi_2_lo)));
+
+    const Packet z = pmul(r, r);
+    const Packet s = pmadd(pmul(z, r), horner(z, constants_t::sin), r);
+    const Packet c =
+        pmadd(pmul(z, z), horner(z, constants_t::cos),
+              psub(pset1<Packet>(T(1)), pmul(z, pset1<Packet>(T(0.5)))));
+
+    /// quadrant q = j mod 4: q = 1, 3 swap sin and cos, q = 2, 3 negate sin
+    /// and q = 1, 2 negate cos
+    const Packet one = pset1<Packet>(T(1));
+    const Packet half = pset1<Packet>(T(0.5));
+    const Packet one_half = pset1<Packet>(T(1.5));
+    const Packet q = quadrant(j);
+    const Packet odd = selectLess(one_half, q, psub(q, pset1<Packet>(T(2))), q);
+    const Packet swapped_sin = selectLess(half, odd, c, s);
+    const Packet swapped_cos = selectLess(half, odd, s, c);
+    sin = selectLess(one_half, q, pnegate(swapped_sin), swapped_sin);
+    cos = selectLess(pabs(psub(q, one_half)), one, pnegate(swapped_cos),
+                     swapped_cos);
+  }
+
+ private:
+  /// j mod 4, taken from the two lowest bits where the packet has an integer
+  /// counterpart
+  template <typename Packet>
+  inline static Packet quadrant(const Packet &j) {
+    using namespace Eigen::internal;
+    if constexpr (HasIntegerPacket<Packet>::value) {
+      using integer_t = typename unpacket_traits<Packet>::integer_packet;
+      return pcast<integer_t, Packet>(
+          pand(pcast<Packet, integer_t>(j), pset1<integer_t>(3)));
+    } else {
+      return psub(j, pmul(pset1<Packet>(T(4)),
+                          pfloor(pmul(j, pset1<Packet>(T(0.25))))));
+    }
+  }
+};
+
+/**
+ * @brief pi/4 split in two parts for the shift
+ *        atan(t) = pi/4 + atan((t - 1) / (t + 1)) of arguments above
+ *        tan(pi/8), which keeps the reduced argument within the bound.
+ */
+template <typename T>
+struct AtanConstants;
+
+template <>
+struct AtanConstants<float> {
+  static constexpr float bound = 0.414213562373095f;
+  static constexpr float pi_4_hi = 0.785398185253143310546875f;
+  static constexpr float pi_4_lo = -2.18556950119e-8f;
+};
+
+template <>
+struct AtanConstants<double> {
+  static constexpr double bound = 0.414213562373095048801688724;
+  static constexpr double pi_4_hi = 7.85398163397448279000e-1;
+  static constexpr double pi_4_lo = 3.06161699786838301793e-17;
+};
+
+/**
+ * @brief atan(u) = u p(u^2) for |u| <= tan(pi/8) with the minimax
+ *        polynomial p = AtanPolynomial.
+ */
+template <typename T, ExpAccuracy Accuracy>
+struct AtanKernel {
+  using polynomial_t = AtanPolynomial<T, Accuracy>;
+
+  template <typename Packet>
+  inline static Packet eval(const Packet &u) {
+    using namespace Eigen::internal;
+    constexpr std::size_t degree = polynomial_t::degree;
+    const auto &c = polynomial_t::coefficients;
+    const Packet z = pmul(u, u);
+    const Packet z2 = pmul(z, z);
+    /// even and odd coefficients as two independent Horner chains in z^2
+    Packet even = pset1<Packet>(c[degree - degree % 2]);
+    for (std::size_t i = degree - degree % 2; i > 0; i -= 2)
+      even = pmadd(even, z2, pset1<Packet>(c[i - 2]));
+    Packet odd = pset1<Packet>(c[degree - 1 + degree % 2]);
+    for (std::size_t i = degree - 1 + degree % 2; i > 1; i -= 2)
+      odd = pmadd(odd, z2, pset1<Packet>(c[i - 2]));
+    return pmul(u, pmadd(odd, z, even));
+  }
+};
+
+template <typename T, ExpAccuracy Accuracy>
+struct Atan2Kernel {
+  using packet_t = typename Eigen::internal::packet_traits<T>::type;
+  using atan_t = AtanKernel<T, Accuracy>;
+  using constants_t = AtanConstants<T>;
+
+  static constexpr std::size_t packet_size = static_cast<std::size_t>(
+      Eigen::internal::unpacket_traits<packet_t>::size);
+
+  /// atan(lo / hi) of the absolute values, mirrored into the quadrant, the
+  /// shift of atan is applied to lo / hi, so only one division is needed
+  template <typename Packet>
+  inline static Packet eval(const Packet &y, const Packet &x) {
+    using namespace Eigen::internal;
+    const Packet ax = pabs(x);
+    const Packet ay = pabs(y);
+    const Packet hi = pmax(ax, ay);
+    const Packet lo = pmin(ax, ay);
+    const Packet zero = pzero(x);
+    const Packet threshold = pmul(hi, pset1<Packet>(constants_t::bound));
+    /// atan2(0, 0) = 0 without dividing by zero
+    const Packet den = selectLess(zero, hi, hi, pset1<Packet>(T(1)));
+    const Packet u = pdiv(selectLess(threshold, lo, psub(lo, hi), lo),
+                          selectLess(threshold, lo, padd(lo, hi), den));
+    Packet r = atan_t::eval(u);
+    r = selectLess(threshold, lo,
+                   padd(padd(r, pset1<Packet>(constants_t::pi_4_lo)),
+                        pset1<Packet>(constants_t::pi_4_hi)),
+                   r);
+    r = selectLess(ax, ay, psub(pset1<Packet>(T(M_PI_2)), r), r);
+    r = selectLess(x, zero, psub(pset1<Packet>(T(M_PI)), r), r);
+    return selectLess(y, zero, pnegate(r), r);
+  }
+};
+
+template <typename T>
+struct HypotKernel {
+  using packet_t = typename Eigen::internal::packet_traits<T>::type;
+
+  static constexpr std::size_t packet_size = static_cast<std::size_t>(
+      Eigen::internal::unpacket_traits<packet_t>::size);
+
+  template <typename Packet>
+  inline static Packet eval(const Packet &x, const Packet &y) {
+    using namespace Eigen::internal;
+    return psqrt(pmadd(x, x, pmul(y, y)));
+  }
+};
+}  // namespace detail
+
+/// Scalar forms
+/**
+ * @brief sin and cos of the same angle with one range reduction.
+ *        Maximum absolute error: 1e-7 (float, |angle| <= 8192) and 3e-16
+ *        (double, |angle| <= 1e6), larger angles lose the precision of the
+ *        reduction.
+ */
+template <typename T>
+inline void sincos(const T angle, T &sin, T &cos) {
+  detail::SinCosKernel<T>::eval(angle, sin, cos);
+}
+
+/**
+ * @brief Four-quadrant arctangent in [-pi, pi], atan2(0, 0) = 0.
+ *        Maximum absolute error of the Full tier: 3e-7 (float) / 5e-16
+ *        (double), Coarse and Fine see AtanPolynomial.
+ */
+template <ExpAccuracy Accuracy = ExpAccuracy::Full, typename T>
+inline T atan2(const T y, const T x) {
+  return detail::Atan2Kernel<T, Accuracy>::eval(y, x);
+}
+
+/**
+ * @brief sqrt(x^2 + y^2) without the over- and underflow protection of
+ *        std::hypot, i.e. |x| and |y| have to stay below sqrt(max) and should
+ *        stay above sqrt(min). Maximum relative error: 3e-7 (float) / 3e-16
+ *        (double).
+ */
+template <typename T>
+inline T hypot(const T x, const T y) {
+  return detail::HypotKernel<T>::eval(x, y);
+}
+
+/// Array forms, full packets are processed with SIMD, the remainder one by
+/// one. No alignment is required, outputs may alias inputs.
+/**
+ * @brief sin[i], cos[i] = sincos(angles[i]) for i < n.
+ */
+template <typename T>
+inline void sincos(const T *angles, T *sin, T *cos, const std::size_t n) {
+  using namespace Eigen::internal;
+  using kernel_t = detail::SinCosKernel<T>;
+  using packet_t = typename kernel_t::packet_t;
+
+  std::size_t i = 0;
+  for (; i + kernel_t::packet_size <= n; i += kernel_t::packet_size) {
+    packet_t s;
+    packet_t c;
+    kernel_t::eval(ploadu<packet_t>(angles + i), s, c);
+    pstoreu(sin + i, s);
+    pstoreu(cos + i, c);
+  }
+  for (; i < n; ++i) kernel_t::eval(angles[i], sin[i], cos[i]);
+}
+
+/**
+ * @brief out[i] = atan2(y[i], x[i]) for i < n.
+ */
+template <ExpAccuracy Accuracy = ExpAccuracy::Full, typename T>
+inline void atan2(const T *y, const T *x, T *out, const std::size_t n) {
+  using namespace Eigen::internal;
+  using kernel_t = detail::Atan2Kernel<T, Accuracy>;
+  using packet_t = typename kernel_t::packet_t;
+
+  std::size_t i = 0;
+  for (; i + kernel_t::packet_size <= n; i += kernel_t::packet_size) {
+    pstoreu(out + i, kernel_t::eval(ploadu<packet_t>(y + i),
+                                    ploadu<packet_t>(x + i)));
+  }
+  for (; i < n; ++i) out[i] = kernel_t::eval(y[i], x[i]);
+}
+
+/**
+ * @brief out[i] = hypot(x[i], y[i]) for i < n.
+ */
+template <typename T>
+inline void hypot(const T *x, const T *y, T *out, const std::size_t n) {
+  using namespace Eigen::internal;
+  using kernel_t = detail::HypotKernel<T>;
+  using packet_t = typename kernel_t::packet_t;
+
+  std::size_t i = 0;
+  for (; i + kernel_t::packet_size <= n; i += kernel_t::packet_size) {
+    pstoreu(out + i, kernel_t::eval(ploadu<packet_t>(x + i),
+                                    ploadu<packet_t>(y + i)));
+  }
+  for (; i < n; ++i) out[i] = kernel_t::eval(x[i], y[i]);
+}
+}  // namespace approx
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_TRIGONOMETRIC_HPP
@@ -0,0 +1,68 @@
+#ifndef CSLIBS_MATH_FAST_ANGLE_HPP
+#define CSLIBS_MATH_FAST_ANGLE_HPP
+
+#include <cmath>
+#include <complex>
+#include <cslibs_math/approx/trigonometric.hpp>
+
+namespace cslibs_math {
+namespace common {
+namespace angle {
+/**
+ * Opt-in fast variants of the functions in angle.hpp, results may differ
+ * from the default ones in the last bits and at the interval bounds.
+ */
+namespace fast {
+/**
+ * @brief normalize between -pi and pi, the multiple of 2 pi is found by
+ *        rounding instead of flooring
+ * @param angle
+ * @return
+ */
+template <typename T>
+inline T normalize(const T angle) {
+  constexpr T _2_M_PI = 2.0 * static_cast<T>(M_PI);
+  constexpr T _1_2_M_PI = 1.0 / _2_M_PI;
+  return angle - _2_M_PI * std::rint(angle * _1_2_M_PI);
+}
+
+/**
+ * @brief difference calculates the normalized angle difference by
+ *        normalizing a - b once, without any trigonometric function.
+ * @param a - first angle in term
+ * @param b - second angle in term
+ * @return
+ */
+template <typename T>
+inline T difference(const T a, const T b) {
+  return normalize(a - b);
+}
+
+/**
+ * @brief fromComplex with the polynomial approx::atan2.
+ * @param complex - the complex representation of the angle
+ * @return        - the angle in radian
+ */
+template <typename T>
+inline T fromComplex(const std::complex<T> &complex) {
+  return approx::atan2(complex.imag(), complex.real());
+}
+
+/**
+ * @brief toComplex with the polynomial approx::sincos.
+ * @param rad   - the angle in radian
+ * @return      - the angle in its complex representation
+ */
+template <typename T>
+inline std::complex<T> toComplex(const T rad) {
+  T sin;
+  T cos;
+  approx::sincos(rad, sin, cos);
+  return std::complex<T>(cos, sin);
+}
+}  // namespace fast
+}  // namespace angle
+}  // namespace common
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_FAST_ANGLE_HPP
@@ -0,0 +1,203 @@
+#ifndef CSLIBS_MATH_CHOLESKY_HPP
+#define CSLIBS_MATH_CHOLESKY_HPP
+
+#include <cmath>
+#include <cslibs_math/linear/symmetric_inverse.hpp>
+#include <eigen3/Eigen/Cholesky>
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/LU>
+
+namespace cslibs_math {
+namespace linear {
+/**
+ * @brief The Cholesky struct computes inverse, determinant and logarithm of
+ *        the determinant of a symmetric positive definite matrix from its
+ *        LLT factor. The log-determinant is summed from the diagonal of the
+ *        factor and does not underflow for small covariances.
+ *        Matrices which are not positive definite fall back to the general
+ *        inverse and determinant, the returned factor is zero then.
+ *        Dim = 2 and Dim = 3 are computed in closed form, see below.
+ */
+template <typename T, std::size_t Dim>
+struct Cholesky {
+  using matrix_t = Eigen::Matrix<T, Dim, Dim>;
+
+  /**
+   * @brief Factorize matrix = lower * lower^T.
+   * @return false if the fallback had to be used
+   */
+  inline static bool compute(const matrix_t &matrix, matrix_t &lower,
+                             matrix_t &inverse, T &determinant,
+                             T &log_determinant) {
+    const Eigen::LLT<matrix_t> llt(matrix);
+    if (llt.info() != Eigen::Success) {
+      lower.setZero();
+      inverse = matrix.inverse();
+      determinant = matrix.determinant();
+      log_determinant = std::log(determinant);
+      return false;
+    }
+
+    lower = llt.matrixL();
+    inverse = llt.solve(matrix_t::Identity());
+    log_determinant = T(2) * lower.diagonal().array().log().sum();
+    determinant = std::exp(log_determinant);
+    return true;
+  }
+
+  /**
+   * @brief Inverse only, see above.
+   */
+  inline static bool compute(const matrix_t &matrix, matrix_t &inverse) {
+    const Eigen::LLT<matrix_t> llt(matrix);
+    if (llt.info() != Eigen::Success) {
+      inverse = matrix.inverse();
+      return false;
+    }
+
+    inverse = llt.solve(matrix_t::Identity());
+    return true;
+  }
+};
+
+/**
+ * @brief Closed form for Dim = 2. The factor is built row by row, the
+ *        pivots, its squared diagonal, test positive definiteness. Inverse
+ *        and log-determinant are taken from the factor, so that they do not
+ *        underflow with the determinant for small matrices. The fallback is
+ *        the adjugate.
+ */
+template <typename T>
+struct Cholesky<T, 2> {
+  using matrix_t = Eigen::Matrix<T, 2, 2>;
+
+  inline static bool compute(const matrix_t &matrix, matrix_t &lower,
+                             matrix_t &inverse, T &determinant,
+                             T &log_determinant) {
+    const T d0 = matrix(0, 0);
+    if (!(d0 > T()))
+      return fallback(matrix, lower, inverse, determinant, log_determinant);
+    const T l00 = std::sqrt(d0);
+    const T l10 = matrix(0, 1) / l00;
+    const T d1 = matrix(1, 1) - l10 * l10;
+    if (!(d1 > T()))
+      return fallback(matrix, lower, inverse, determinant, log_determinant);
+
+    lower(0, 0) = l00;
+    lower(0, 1) = T();
+    lower(1, 0) = l10;
+    lower(1, 1) = std::sqrt(d1);
+
+    /// inverse = lower^-T * lower^-1
+    const T i11 = T(1) / d1;
+    inverse(0, 0) = (T(1) + l10 * l10 * i11) / d0;
+    inverse(0, 1) = inverse(1, 0) = -l10 * i11 / l00;
+    inverse(1, 1) = i11;
+    determinant = d0 * d1;
+    log_determinant = std::log(d0) + std::log(d1);
+    return true;
+  }
+
+  inline static bool compute(const matrix_t &matrix, matrix_t &inverse) {
+    return positiveDefinite(matrix,
+                            SymmetricInverse<T, 2>::compute(matrix, inverse));
+  }
+
+ private:
+  inline static bool positiveDefinite(const matrix_t &matrix,
+                                      const T determinant) {
+    return matrix(0, 0) > T() && determinant > T();
+  }
+
+  inline static bool fallback(const matrix_t &matrix, matrix_t &lower,
+                              matrix_t &inverse, T &determinant,
+                              T &log_determinant) {
+    lower.setZero();
+    determinant = SymmetricInverse<T, 2>::compute(matrix, inverse);
+    log_determinant = std::log(determinant);
+    return false;
+  }
+};
+
+/**
+ * @brief Closed form for Dim = 3, see above.
+ */
+template <typename T>
+struct Cholesky<T, 3> {
+  using matrix_t = Eigen::Matrix<T, 3, 3>;
+
+  inline static bool compute(const matrix_t &matrix, matrix_t &lower,
+                             matrix_t &inverse, T &determinant,
+                             T &log_determinant) {
+    const T d0 = matrix(0, 0);
+    if (!(d0 > T()))
+      return fallback(matrix, lower, inverse, determinant, log_determinant);
+    const T l00 = std::sqrt(d0);
+    const T l10 = matrix(0, 1) / l00;
+    const T l20 = matrix(0, 2) / l00;
+    const T d1 = matrix(1, 1) - l10 * l10;
+    if (!(d1 > T()))
+      return fallback(matrix, lower, inverse, determinant, log_determinant);
+    const T l11 = std::sqrt(d1);
+    const T l21 = (matrix(1, 2) - l20 * l10) / l11;
+    const T d2 = matrix(2, 2) - l20 * l20 - l21 * l21;
+    if (!(d2 > T()))
+      return fallback(matrix, lower, inverse, determinant, log_determinant);
+    const T l22 = std::sqrt(d2);
+
+    lower(0, 0) = l00;
+    lower(0, 1) = T();
+    lower(0, 2) = T();
+    lower(1, 0) = l10;
+    lower(1, 1) = l11;
+    lower(1, 2) = T();
+    lower(2, 0) = l20;
+    lower(2, 1) = l21;
+    lower(2, 2) = l22;
+
+    /// inverse = lower^-T * lower^-1, with the lower triangular lower^-1
+    const T j00 = T(1) / l00;
+    const T j11 = T(1) / l11;
+    const T j22 = T(1) / l22;
+    const T j10 = -l10 * j00 * j11;
+    const T j21 = -l21 * j11 * j22;
+    const T j20 = -(l20 * j00 + l21 * j10) * j22;
+    inverse(0, 0) = j00 * j00 + j10 * j10 + j20 * j20;
+    inverse(0, 1) = inverse(1, 0) = j10 * j11 + j20 * j21;
+    inverse(0, 2) = inverse(2, 0) = j20 * j22;
+    inverse(1, 1) = j11 * j11 + j21 * j21;
+    inverse(1, 2) = inverse(2, 1) = j21 * j22;
+    inverse(2, 2) = j22 * j22;
+    determinant = d0 * d1 * d2;
+    log_determinant = std::log(d0) + std::log(d1) + std::log(d2);
+    return true;
+  }
+
+  inline static bool compute(const matrix_t &matrix, matrix_t &inverse) {
+    const T determinant = SymmetricInverse<T, 3>::compute(matrix, inverse);
+    return positiveDefinite(matrix, leadingMinor(matrix), determinant);
+  }
+
+ private:
+  inline static T leadingMinor(const matrix_t &matrix) {
+    return matrix(0, 0) * matrix(1, 1) - matrix(0, 1) * matrix(0, 1);
+  }
+
+  inline static bool positiveDefinite(const matrix_t &matrix, const T minor,
+                                      const T determinant) {
+    return matrix(0, 0) > T() && minor > T() && determinant > T();
+  }
+
+  inline static bool fallback(const matrix_t &matrix, matrix_t &lower,
+                              matrix_t &inverse, T &determinant,
+                              T &log_determinant) {
+    lower.setZero();
+    determinant = SymmetricInverse<T, 3>::compute(matrix, inverse);
+    log_determinant = std::log(determinant);
+    return false;
+  }
+};
+}  // namespace linear
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_CHOLESKY_HPP
@@ -0,0 +1,36 @@
+#ifndef CSLIBS_MATH_MAHALANOBIS_HPP
+#define CSLIBS_MATH_MAHALANOBIS_HPP
+
+#include <eigen3/Eigen/Core>
+
+namespace cslibs_math {
+namespace linear {
+/**
+ * @brief The Mahalanobis struct evaluates squared Mahalanobis distances of
+ *        many points to one mean. Points are stored column-wise, for small
+ *        dimensions the fixed-size per-column quadratic form vectorizes
+ *        better than one large matrix product over all points.
+ */
+template <typename T, std::size_t Dim>
+struct Mahalanobis {
+  using vector_t = Eigen::Matrix<T, Dim, 1>;
+  using matrix_t = Eigen::Matrix<T, Dim, Dim>;
+  using points_t = Eigen::Matrix<T, Dim, Eigen::Dynamic>;
+  using distances_t = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+  /**
+   * @brief distances(k) = (p_k - mean)^T * information * (p_k - mean)
+   */
+  inline static void squared(const vector_t &mean, const matrix_t &information,
+                             const points_t &points, distances_t &distances) {
+    distances.resize(points.cols());
+    for (Eigen::Index k = 0; k < points.cols(); ++k) {
+      const vector_t q = points.col(k) - mean;
+      distances(k) = q.dot(information * q);
+    }
+  }
+};
+}  // namespace linear
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_MAHALANOBIS_HPP
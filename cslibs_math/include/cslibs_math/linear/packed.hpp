@@ -0,0 +1,19 @@
+#ifndef CSLIBS_MATH_PACKED_HPP
+#define CSLIBS_MATH_PACKED_HPP
+
+#include <cstddef>
+
+namespace cslibs_math {
+namespace linear {
+/**
+ * @brief Index of the entry (i, j), i <= j, in a row-major packed upper
+ *        triangle of a Dim x Dim matrix.
+ */
+template <std::size_t Dim>
+inline constexpr std::size_t packed(const std::size_t i, const std::size_t j) {
+  return i * Dim - (i * (i + 1)) / 2 + j;
+}
+}  // namespace linear
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_PACKED_HPP
@@ -0,0 +1,256 @@
+#ifndef CSLIBS_MATH_SYMMETRIC_EIGEN_HPP
+#define CSLIBS_MATH_SYMMETRIC_EIGEN_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Eigenvalues>
+#include <limits>
+
+namespace cslibs_math {
+namespace linear {
+/**
+ * @brief The SymmetricEigen struct computes the eigen decomposition of a
+ *        symmetric (self-adjoint) matrix, only the upper triangle is read.
+ *        Eigen values are sorted in increasing order, the eigen vectors are
+ *        the normalized columns of the returned matrix.
+ *        Dim = 2 and Dim = 3 are solved in closed form, all other dimensions
+ *        use Eigen::SelfAdjointEigenSolver.
+ */
+template <typename T, std::size_t Dim>
+struct SymmetricEigen {
+  using matrix_t = Eigen::Matrix<T, Dim, Dim>;
+  using eigen_values_t = Eigen::Matrix<T, Dim, 1>;
+  using eigen_vectors_t = Eigen::Matrix<T, Dim, Dim>;
+
+  inline static void compute(const matrix_t &matrix,
+                             eigen_values_t &eigen_values,
+                             eigen_vectors_t &eigen_vectors) {
+    Eigen::SelfAdjointEigenSolver<matrix_t> solver(matrix,
+                                                   Eigen::ComputeEigenvectors);
+    eigen_values = solver.eigenvalues();
+    eigen_vectors = solver.eigenvectors();
+  }
+
+  inline static void compute(const matrix_t &matrix,
+                             eigen_values_t &eigen_values) {
+    Eigen::SelfAdjointEigenSolver<matrix_t> solver(matrix,
+                                                   Eigen::EigenvaluesOnly);
+    eigen_values = solver.eigenvalues();
+  }
+};
+
+/**
+ * @brief Analytic solution, the eigen vectors are the rotation by half the
+ *        angle of the off-diagonal entry.
+ */
+template <typename T>
+struct SymmetricEigen<T, 2> {
+  using matrix_t = Eigen::Matrix<T, 2, 2>;
+  using eigen_values_t = Eigen::Matrix<T, 2, 1>;
+  using eigen_vectors_t = Eigen::Matrix<T, 2, 2>;
+
+  inline static void compute(const matrix_t &matrix,
+                             eigen_values_t &eigen_values,
+                             eigen_vectors_t &eigen_vectors) {
+    compute(matrix, eigen_values);
+
+    const T theta =
+        T(0.5) * std::atan2(T(2) * matrix(0, 1), matrix(0, 0) - matrix(1, 1));
+    const T s = std::sin(theta);
+    const T c = std::cos(theta);
+    eigen_vectors(0, 0) = -s;
+    eigen_vectors(1, 0) = c;
+    eigen_vectors(0, 1) = c;
+    eigen_vectors(1, 1) = s;
+  }
+
+  inline static void compute(const matrix_t &matrix,
+                             eigen_values_t &eigen_values) {
+    const T mean = T(0.5) * (matrix(0, 0) + matrix(1, 1));
+    const T d = std::hypot(T(0.5) * (matrix(0, 0) - matrix(1, 1)),
+                           matrix(0, 1));
+    eigen_values(0) = mean - d;
+    eigen_values(1) = mean + d;
+  }
+};
+
+/**
+ * @brief Trigonometric solution of the characteristic cubic, eigen vectors
+ *        are extracted from the kernel of (A - lambda * I) via cross products
+ *        of its rows. The matrix is scaled to unit magnitude beforehand to
+ *        avoid over- and underflow.
+ *        Without eigen vectors, close to double eigen values the accuracy
+ *        drops to about sqrt(epsilon) relative to the largest entry.
+ */
+template <typename T>
+struct SymmetricEigen<T, 3> {
+  using matrix_t = Eigen::Matrix<T, 3, 3>;
+  using vector_t = Eigen::Matrix<T, 3, 1>;
+  using eigen_values_t = Eigen::Matrix<T, 3, 1>;
+  using eigen_vectors_t = Eigen::Matrix<T, 3, 3>;
+
+  inline static void compute(const matrix_t &matrix,
+                             eigen_values_t &eigen_values,
+                             eigen_vectors_t &eigen_vectors) {
+    matrix_t m;
+    const T scale = normalized(matrix, m);
+    if (scale == T()) {
+      eigen_values.setZero();
+      eigen_vectors.setIdentity();
+      return;
+    }
+
+    if (!values(m, eigen_values)) {
+      /// the matrix is diagonal
+      sortDiagonal(m, eigen_values, eigen_vectors);
+      eigen_values *= scale;
+      return;
+    }
+
+    /// start with the eigen value which is separated most from the middle
+    /// one, it is guaranteed to be simple
+    const bool first_isolated = (eigen_values(1) - eigen_values(0)) >
+                                (eigen_values(2) - eigen_values(1));
+    const int a = first_isolated ? 0 : 2;
+    const int b = first_isolated ? 2 : 0;
+
+    vector_t va;
+    if (!kernel(m, eigen_values(a), va)) va = vector_t::UnitX();
+
+    vector_t vb;
+    if (!kernel(m, eigen_values(b), vb)) vb = orthogonal(va);
+    vb -= va * va.dot(vb);
+    const T nb = vb.norm();
+    vb = nb > std::sqrt(std::numeric_limits<T>::epsilon()) ? vector_t(vb / nb)
+                                                           : orthogonal(va);
+
+    eigen_vectors.col(a) = va;
+    eigen_vectors.col(b) = vb;
+    eigen_vectors.col(1) = eigen_vectors.col(2).cross(eigen_vectors.col(0));
+    eigen_vectors.col(1).normalize();
+
+    /// the cubic loses precision close to double roots, the rayleigh
+    /// quotients of the orthonormal eigen vectors do not
+    for (int i = 0; i < 3; ++i) {
+      eigen_values(i) =
+          eigen_vectors.col(i).dot(m * eigen_vectors.col(i)) * scale;
+    }
+  }
+
+  inline static void compute(const matrix_t &matrix,
+                             eigen_values_t &eigen_values) {
+    matrix_t m;
+    const T scale = normalized(matrix, m);
+    if (scale == T()) {
+      eigen_values.setZero();
+      return;
+    }
+    if (!values(m, eigen_values)) {
+      eigen_vectors_t unused;
+      sortDiagonal(m, eigen_values, unused);
+    }
+    eigen_values *= scale;
+  }
+
+ private:
+  inline static T normalized(const matrix_t &matrix, matrix_t &m) {
+    T scale = T();
+    for (int i = 0; i < 3; ++i)
+      for (int j = i; j < 3; ++j)
+        scale = std::max(scale, std::abs(matrix(i, j)));
+    if (scale == T()) return scale;
+
+    const T s = T(1) / scale;
+    for (int i = 0; i < 3; ++i) {
+      for (int j = i; j < 3; ++j) {
+        m(i, j) = matrix(i, j) * s;
+        m(j, i) = m(i, j);
+      }
+    }
+    return scale;
+  }
+
+  /**
+   * @brief Eigen values in increasing order, returns false if the matrix is
+   *        diagonal, the values are then left untouched.
+   */
+  inline static bool values(const matrix_t &m, eigen_values_t &eigen_values) {
+    const T p1 = m(0, 1) * m(0, 1) + m(0, 2) * m(0, 2) + m(1, 2) * m(1, 2);
+    if (p1 == T()) return false;
+
+    const T q = m.trace() / T(3);
+    const T d0 = m(0, 0) - q;
+    const T d1 = m(1, 1) - q;
+    const T d2 = m(2, 2) - q;
+    const T p = std::sqrt((d0 * d0 + d1 * d1 + d2 * d2 + T(2) * p1) / T(6));
+
+    /// half the determinant of B = (A - q * I) / p
+    const T b01 = m(0, 1);
+    const T b02 = m(0, 2);
+    const T b12 = m(1, 2);
+    const T det = d0 * (d1 * d2 - b12 * b12) - b01 * (b01 * d2 - b12 * b02) +
+                  b02 * (b01 * b12 - d1 * b02);
+    T r = det / (T(2) * p * p * p);
+    r = std::max(T(-1), std::min(T(1), r));
+
+    const T phi = std::acos(r) / T(3);
+    const T two_pi_3 = static_cast<T>(2.0 * M_PI / 3.0);
+    eigen_values(2) = q + T(2) * p * std::cos(phi);
+    eigen_values(0) = q + T(2) * p * std::cos(phi + two_pi_3);
+    eigen_values(1) = T(3) * q - eigen_values(0) - eigen_values(2);
+    return true;
+  }
+
+  inline static void sortDiagonal(const matrix_t &m,
+                                  eigen_values_t &eigen_values,
+                                  eigen_vectors_t &eigen_vectors) {
+    int order[3] = {0, 1, 2};
+    if (m(order[0], order[0]) > m(order[1], order[1]))
+      std::swap(order[0], order[1]);
+    if (m(order[1], order[1]) > m(order[2], order[2]))
+      std::swap(order[1], order[2]);
+    if (m(order[0], order[0]) > m(order[1], order[1]))
+      std::swap(order[0], order[1]);
+
+    eigen_vectors.setZero();
+    for (int i = 0; i < 3; ++i) {
+      eigen_values(i) = m(order[i], order[i]);
+      eigen_vectors(order[i], i) = T(1);
+    }
+  }
+
+  /**
+   * @brief Unit vector spanning the kernel of (m - lambda * I), returns
+   *        false if the kernel is more than one-dimensional.
+   */
+  inline static bool kernel(const matrix_t &m, const T lambda, vector_t &v) {
+    matrix_t s = m;
+    s.diagonal().array() -= lambda;
+
+    const vector_t c0 = s.row(0).transpose().cross(s.row(1).transpose());
+    const vector_t c1 = s.row(0).transpose().cross(s.row(2).transpose());
+    const vector_t c2 = s.row(1).transpose().cross(s.row(2).transpose());
+    const T n0 = c0.squaredNorm();
+    const T n1 = c1.squaredNorm();
+    const T n2 = c2.squaredNorm();
+
+    const vector_t &c = (n0 >= n1 && n0 >= n2) ? c0 : (n1 >= n2 ? c1 : c2);
+    const T n = std::max(n0, std::max(n1, n2));
+    if (n <= std::numeric_limits<T>::epsilon()) return false;
+
+    v = c / std::sqrt(n);
+    return true;
+  }
+
+  inline static vector_t orthogonal(const vector_t &v) {
+    const vector_t o = std::abs(v(0)) > std::abs(v(1))
+                           ? vector_t(-v(2), T(), v(0))
+                           : vector_t(T(), v(2), -v(1));
+    return o.normalized();
+  }
+};
+}  // namespace linear
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_SYMMETRIC_EIGEN_HPP
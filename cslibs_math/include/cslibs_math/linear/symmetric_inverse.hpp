@@ -0,0 +1,74 @@
+#ifndef CSLIBS_MATH_SYMMETRIC_INVERSE_HPP
+#define CSLIBS_MATH_SYMMETRIC_INVERSE_HPP
+
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/LU>
+
+namespace cslibs_math {
+namespace linear {
+/**
+ * @brief The SymmetricInverse struct computes inverse and determinant of a
+ *        symmetric matrix, only the upper triangle is read. Dim = 2 and
+ *        Dim = 3 use the adjugate in closed form, all other dimensions use
+ *        Eigen. Singular matrices yield a zero inverse.
+ */
+template <typename T, std::size_t Dim>
+struct SymmetricInverse {
+  using matrix_t = Eigen::Matrix<T, Dim, Dim>;
+
+  inline static T compute(const matrix_t &matrix, matrix_t &inverse) {
+    /// the LU solve avoids Eigen's fixed-size 4x4 inverse kernel, which
+    /// produces wrong results when compiled with -ffast-math
+    const matrix_t m = matrix.template selfadjointView<Eigen::Upper>();
+    const Eigen::PartialPivLU<matrix_t> lu(m);
+    const T determinant = lu.determinant();
+    if (determinant != T())
+      inverse = lu.solve(matrix_t::Identity());
+    else
+      inverse.setZero();
+    return determinant;
+  }
+};
+
+template <typename T>
+struct SymmetricInverse<T, 2> {
+  using matrix_t = Eigen::Matrix<T, 2, 2>;
+
+  inline static T compute(const matrix_t &m, matrix_t &inverse) {
+    const T determinant = m(0, 0) * m(1, 1) - m(0, 1) * m(0, 1);
+    const T s = determinant != T() ? T(1) / determinant : T();
+    inverse(0, 0) = m(1, 1) * s;
+    inverse(0, 1) = -m(0, 1) * s;
+    inverse(1, 0) = inverse(0, 1);
+    inverse(1, 1) = m(0, 0) * s;
+    return determinant;
+  }
+};
+
+template <typename T>
+struct SymmetricInverse<T, 3> {
+  using matrix_t = Eigen::Matrix<T, 3, 3>;
+
+  inline static T compute(const matrix_t &m, matrix_t &inverse) {
+    /// cofactors, the matrix is symmetric so is its adjugate
+    const T c00 = m(1, 1) * m(2, 2) - m(1, 2) * m(1, 2);
+    const T c01 = m(0, 2) * m(1, 2) - m(0, 1) * m(2, 2);
+    const T c02 = m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1);
+    const T c11 = m(0, 0) * m(2, 2) - m(0, 2) * m(0, 2);
+    const T c12 = m(0, 1) * m(0, 2) - m(0, 0) * m(1, 2);
+    const T c22 = m(0, 0) * m(1, 1) - m(0, 1) * m(0, 1);
+    const T determinant = m(0, 0) * c00 + m(0, 1) * c01 + m(0, 2) * c02;
+    const T s = determinant != T() ? T(1) / determinant : T();
+    inverse(0, 0) = c00 * s;
+    inverse(0, 1) = inverse(1, 0) = c01 * s;
+    inverse(0, 2) = inverse(2, 0) = c02 * s;
+    inverse(1, 1) = c11 * s;
+    inverse(1, 2) = inverse(2, 1) = c12 * s;
+    inverse(2, 2) = c22 * s;
+    return determinant;
+  }
+};
+}  // namespace linear
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_SYMMETRIC_INVERSE_HPP
@@ -0,0 +1,125 @@
+#ifndef CSLIBS_MATH_PHILOX_HPP
+#define CSLIBS_MATH_PHILOX_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace cslibs_math {
+namespace random {
+
+/**
+ * @brief Philox4x32-10 counter-based random generator (Salmon et al., 2011).
+ *        Every block of random bits is a bijection of a 128 bit counter
+ *        under a 64 bit key, the seed. The counter consists of the block
+ *        index and a stream, so that streams of a seed are independent and
+ *        can be assigned to threads or particles, e.g.
+ *        Philox4x32(seed, particle_index), and the results do not depend on
+ *        the number of threads. The state is 48 bytes, copying and
+ *        discard() are cheap.
+ *        Satisfies UniformRandomBitGenerator, so that it can be used as the
+ *        Generator of Uniform and Normal.
+ */
+class Philox4x32 {
+ public:
+  using result_type = std::uint64_t;
+  using counter_t = std::array<std::uint32_t, 4>;
+  using key_t = std::array<std::uint32_t, 2>;
+
+  /**
+   * @param seed   - key shared by all streams
+   * @param stream - index of the stream, e.g. of a thread or particle
+   */
+  explicit Philox4x32(const std::uint64_t seed = 0,
+                      const std::uint64_t stream = 0)
+      : key_{{static_cast<std::uint32_t>(seed),
+              static_cast<std::uint32_t>(seed >> 32)}},
+        stream_{stream} {}
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  inline void seed(const std::uint64_t seed, const std::uint64_t stream = 0) {
+    *this = Philox4x32(seed, stream);
+  }
+
+  inline std::uint64_t stream() const { return stream_; }
+
+  /**
+   * @brief Generator of another stream with the same seed, starting at its
+   *        beginning.
+   */
+  inline Philox4x32 split(const std::uint64_t stream) const {
+    Philox4x32 other(*this);
+    other.stream_ = stream;
+    other.position_ = 0;
+    other.block_index_ = NONE;
+    return other;
+  }
+
+  inline result_type operator()() {
+    const std::uint64_t index = position_ >> 1;
+    if (index != block_index_) {
+      block_ = block(counter(index), key_);
+      block_index_ = index;
+    }
+    const std::size_t i = (position_ & 1u) << 1;
+    ++position_;
+    return (static_cast<result_type>(block_[i + 1]) << 32) | block_[i];
+  }
+
+  /**
+   * @brief Skips n results in constant time.
+   */
+  inline void discard(const unsigned long long n) { position_ += n; }
+
+  /**
+   * @brief Ten Philox rounds of the counter under the key.
+   */
+  static inline counter_t block(counter_t counter, key_t key) {
+    for (std::size_t r = 0; r < 10; ++r) {
+      if (r > 0) {
+        key[0] += W0;
+        key[1] += W1;
+      }
+      const std::uint64_t p0 = static_cast<std::uint64_t>(M0) * counter[0];
+      const std::uint64_t p1 = static_cast<std::uint64_t>(M1) * counter[2];
+      counter = {{static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+                  static_cast<std::uint32_t>(p1),
+                  static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+                  static_cast<std::uint32_t>(p0)}};
+    }
+    return counter;
+  }
+
+ private:
+  static constexpr std::uint32_t M0 = 0xD2511F53u;
+  static constexpr std::uint32_t M1 = 0xCD9E8D57u;
+  static constexpr std::uint32_t W0 = 0x9E3779B9u;
+  static constexpr std::uint32_t W1 = 0xBB67AE85u;
+  /// no block is cached, there are at most 2^63 blocks per stream
+  static constexpr std::uint64_t NONE =
+      std::numeric_limits<std::uint64_t>::max();
+
+  inline counter_t counter(const std::uint64_t index) const {
+    return {{static_cast<std::uint32_t>(index),
+             static_cast<std::uint32_t>(index >> 32),
+             static_cast<std::uint32_t>(stream_),
+             static_cast<std::uint32_t>(stream_ >> 32)}};
+  }
+
+  key_t key_;
+  std::uint64_t stream_;
+  std::uint64_t position_ = 0;  /// results drawn, two per block
+  std::uint64_t block_index_ = NONE;
+  counter_t block_{};
+};
+
+}  // namespace random
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_PHILOX_HPP
@@ -4,6 +4,7 @@
 #include <array>
 #include <cmath>
 #include <cslibs_math/common/equal.hpp>
+#include <cslibs_math/random/philox.hpp>
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Eigen>
 #include <memory>
@@ -14,7 +15,8 @@ namespace random {
 
 /**
  * @brief Interface for random generator independent from dimensionality and
- * distribution type.
+ * distribution type. Parallel sampling should pass a Philox4x32 generator of
+ * its own stream, e.g. per thread or particle, to stay reproducible.
  */
 template <typename Generator = std::mt19937_64>
 class RandomGenerator {
@@ -22,13 +24,14 @@ class RandomGenerator {
   typedef std::shared_ptr<RandomGenerator> Ptr;
 
  protected:
-  RandomGenerator() : random_engine_{random_device_()} {}
+  RandomGenerator() : random_engine_{std::random_device{}()} {}
 
   RandomGenerator(const unsigned int seed) : random_engine_{seed} {}
 
+  RandomGenerator(const Generator &generator) : random_engine_{generator} {}
+
   RandomGenerator(const RandomGenerator &other) = delete;
 
-  std::random_device random_device_;
   Generator random_engine_;
 };
 
@@ -55,6 +58,11 @@ class EIGEN_ALIGN16 Uniform : public RandomGenerator<Generator> {
     set(min, max);
   }
 
+  Uniform(const sample_t &min, const sample_t &max, const Generator &generator)
+      : RandomGenerator<Generator>{generator} {
+    set(min, max);
+  }
+
   inline void set(const sample_t &min, const sample_t &max) {
     for (std::size_t i = 0; i < Dim; ++i) {
       distributions_[i] = distribution_t(min[i], max[i]);
@@ -102,6 +110,11 @@ class EIGEN_ALIGN16 Uniform<T, 1, Generator>
     set(min, max);
   }
 
+  Uniform(const T min, const T max, const Generator &generator)
+      : RandomGenerator<Generator>{generator} {
+    set(min, max);
+  }
+
   inline void set(const T min, const T max) {
     distribution_ = distribution_t(min, max);
   }
@@ -150,6 +163,12 @@ class EIGEN_ALIGN16 Normal : public RandomGenerator<Generator> {
     set(mean, covariance);
   }
 
+  inline explicit Normal(const sample_t &mean, const matrix_t &covariance,
+                         const Generator &generator)
+      : RandomGenerator<Generator>{generator} {
+    set(mean, covariance);
+  }
+
   inline void set(const sample_t &mean, const matrix_t &covariance) {
     mean_ = mean;
     covariance_ = covariance;
@@ -206,6 +225,12 @@ class EIGEN_ALIGN16 Normal<T, 1, Generator>
     set(mean, _sigma);
   }
 
+  inline explicit Normal(const T mean, const T _sigma,
+                         const Generator &generator)
+      : RandomGenerator<Generator>{generator} {
+    set(mean, _sigma);
+  }
+
   inline void set(const T mean, const T _sigma) {
     distribution_ = distribution_t(mean, _sigma);
   }
@@ -0,0 +1,117 @@
+#ifndef CSLIBS_MATH_SERIALIZATION_COMPACT_DISTRIBUTION_HPP
+#define CSLIBS_MATH_SERIALIZATION_COMPACT_DISTRIBUTION_HPP
+
+#include <yaml-cpp/yaml.h>
+
+#include <cslibs_math/serialization/binary.hpp>
+#include <cslibs_math/statistics/compact_distribution.hpp>
+#include <fstream>
+
+namespace cslibs_math {
+namespace serialization {
+template <template <typename, std::size_t, std::size_t>
+          class distribution_class_t,
+          typename T, std::size_t Dim, std::size_t lambda_ratio_exponent>
+struct binary;
+
+template <typename T, std::size_t Dim, std::size_t lambda_ratio_exponent>
+struct binary<cslibs_math::statistics::CompactDistribution, T, Dim,
+              lambda_ratio_exponent> {
+  using distribution_t =
+      cslibs_math::statistics::CompactDistribution<T, Dim,
+                                                   lambda_ratio_exponent>;
+  using sample_t = typename distribution_t::sample_t;
+  using packed_t = typename distribution_t::packed_t;
+
+  static const std::size_t size = sizeof(std::size_t) + Dim * sizeof(T) +
+                                  distribution_t::PackedSize * sizeof(T);
+
+  inline static std::size_t read(std::ifstream &in,
+                                 distribution_t &distribution) {
+    std::size_t n = io<std::size_t>::read(in);
+
+    if (n > 0) {  // data only exists if n > 0
+      sample_t mean;
+      packed_t s;
+
+      for (std::size_t i = 0; i < Dim; ++i) mean(i) = io<T>::read(in);
+
+      for (std::size_t i = 0; i < distribution_t::PackedSize; ++i)
+        s(i) = io<T>::read(in);
+
+      distribution = distribution_t(n, mean, s);
+      return size;
+    }
+
+    distribution = distribution_t();
+    return sizeof(std::size_t);
+  }
+
+  inline static void write(std::ofstream &out) {
+    io<std::size_t>::write(0, out);
+  }
+
+  inline static void write(const distribution_t &distribution,
+                           std::ofstream &out) {
+    const std::size_t n = distribution.getN();
+    io<std::size_t>::write(n, out);
+
+    if (n > 0) {
+      const sample_t mean = distribution.getMean();
+      const packed_t &s = distribution.getPackedScatter();
+
+      for (std::size_t i = 0; i < Dim; ++i) io<T>::write(mean(i), out);
+
+      for (std::size_t i = 0; i < distribution_t::PackedSize; ++i)
+        io<T>::write(s(i), out);
+    }
+  }
+};
+}  // namespace serialization
+}  // namespace cslibs_math
+
+namespace YAML {
+template <typename T, std::size_t Dim, std::size_t lambda_ratio_exponent>
+struct convert<cslibs_math::statistics::CompactDistribution<
+    T, Dim, lambda_ratio_exponent>> {
+  using distribution_t =
+      cslibs_math::statistics::CompactDistribution<T, Dim,
+                                                   lambda_ratio_exponent>;
+  using sample_t = typename distribution_t::sample_t;
+  using packed_t = typename distribution_t::packed_t;
+
+  static Node encode(const distribution_t &rhs) {
+    Node n;
+    n.push_back(rhs.getN());
+
+    const sample_t mean = rhs.getMean();
+    for (std::size_t i = 0; i < Dim; ++i) n.push_back(mean(i));
+
+    const packed_t &s = rhs.getPackedScatter();
+    for (std::size_t i = 0; i < distribution_t::PackedSize; ++i)
+      n.push_back(s(i));
+
+    return n;
+  }
+
+  static bool decode(const Node &n, distribution_t &rhs) {
+    if (!n.IsSequence() || n.size() != (1 + Dim + distribution_t::PackedSize))
+      return false;
+
+    std::size_t p = 0;
+    std::size_t num = n[p++].as<std::size_t>();
+
+    sample_t mean(sample_t::Zero());
+    for (std::size_t i = 0; i < Dim; ++i) mean(i) = n[p++].as<T>();
+
+    packed_t s(packed_t::Zero());
+    for (std::size_t i = 0; i < distribution_t::PackedSize; ++i)
+      s(i) = n[p++].as<T>();
+
+    rhs = distribution_t(num, mean, s);
+    return true;
+  }
+};
+}  // namespace YAML
+
+#endif  // CSLIBS_MATH_SERIALIZATION_COMPACT_DISTRIBUTION_HPP
@@ -0,0 +1,67 @@
+#ifndef CSLIBS_MATH_SERIALIZATION_HISTOGRAM_HPP
+#define CSLIBS_MATH_SERIALIZATION_HISTOGRAM_HPP
+
+#include <yaml-cpp/yaml.h>
+
+#include <cslibs_math/serialization/binary.hpp>
+#include <cslibs_math/statistics/histogram.hpp>
+#include <fstream>
+
+namespace cslibs_math {
+namespace serialization {
+namespace histogram {
+template <typename T>
+struct binary {
+  using histogram_t = cslibs_math::statistics::Histogram<T>;
+
+  inline static std::size_t read(std::ifstream &in, histogram_t &histogram) {
+    const T min = io<T>::read(in);
+    const T max = io<T>::read(in);
+    typename histogram_t::counts_t counts(io<std::size_t>::read(in));
+    for (std::size_t &c : counts) c = io<std::size_t>::read(in);
+
+    histogram = histogram_t(min, max, counts);
+    return 2 * sizeof(T) + (1 + counts.size()) * sizeof(std::size_t);
+  }
+
+  inline static void write(const histogram_t &histogram, std::ofstream &out) {
+    io<T>::write(histogram.getMin(), out);
+    io<T>::write(histogram.getMax(), out);
+
+    const typename histogram_t::counts_t &counts = histogram.getCounts();
+    io<std::size_t>::write(counts.size(), out);
+    for (const std::size_t c : counts) io<std::size_t>::write(c, out);
+  }
+};
+}  // namespace histogram
+}  // namespace serialization
+}  // namespace cslibs_math
+
+namespace YAML {
+template <typename T>
+struct convert<cslibs_math::statistics::Histogram<T>> {
+  using histogram_t = cslibs_math::statistics::Histogram<T>;
+
+  static Node encode(const histogram_t &rhs) {
+    Node n;
+    n.push_back(rhs.getMin());
+    n.push_back(rhs.getMax());
+    for (const std::size_t c : rhs.getCounts()) n.push_back(c);
+
+    return n;
+  }
+
+  static bool decode(const Node &n, histogram_t &rhs) {
+    if (!n.IsSequence() || n.size() < 5) return false;
+
+    typename histogram_t::counts_t counts(n.size() - 2);
+    for (std::size_t i = 0; i < counts.size(); ++i)
+      counts[i] = n[i + 2].as<std::size_t>();
+
+    rhs = histogram_t(n[0].as<T>(), n[1].as<T>(), counts);
+    return true;
+  }
+};
+}  // namespace YAML
+
+#endif  // CSLIBS_MATH_SERIALIZATION_HISTOGRAM_HPP
@@ -0,0 +1,83 @@
+#ifndef CSLIBS_MATH_SERIALIZATION_QUANTILE_SKETCH_HPP
+#define CSLIBS_MATH_SERIALIZATION_QUANTILE_SKETCH_HPP
+
+#include <yaml-cpp/yaml.h>
+
+#include <cslibs_math/serialization/binary.hpp>
+#include <cslibs_math/statistics/quantile_sketch.hpp>
+#include <fstream>
+
+namespace cslibs_math {
+namespace serialization {
+namespace quantile_sketch {
+template <typename T>
+struct binary {
+  using sketch_t = cslibs_math::statistics::QuantileSketch<T>;
+
+  inline static std::size_t read(std::ifstream &in, sketch_t &sketch) {
+    const std::size_t compression = io<std::size_t>::read(in);
+    const T min = io<T>::read(in);
+    const T max = io<T>::read(in);
+    typename sketch_t::centroids_t centroids(io<std::size_t>::read(in));
+    for (auto &c : centroids) {
+      c.mean = io<T>::read(in);
+      c.weight = io<T>::read(in);
+    }
+
+    sketch = sketch_t(compression, min, max, centroids);
+    return 2 * sizeof(std::size_t) + (2 + 2 * centroids.size()) * sizeof(T);
+  }
+
+  inline static void write(const sketch_t &sketch, std::ofstream &out) {
+    io<std::size_t>::write(sketch.getCompression(), out);
+    io<T>::write(sketch.getMin(), out);
+    io<T>::write(sketch.getMax(), out);
+
+    const typename sketch_t::centroids_t &centroids = sketch.getCentroids();
+    io<std::size_t>::write(centroids.size(), out);
+    for (const auto &c : centroids) {
+      io<T>::write(c.mean, out);
+      io<T>::write(c.weight, out);
+    }
+  }
+};
+}  // namespace quantile_sketch
+}  // namespace serialization
+}  // namespace cslibs_math
+
+namespace YAML {
+template <typename T>
+struct convert<cslibs_math::statistics::QuantileSketch<T>> {
+  using sketch_t = cslibs_math::statistics::QuantileSketch<T>;
+
+  static Node encode(const sketch_t &rhs) {
+    Node n;
+    n.push_back(rhs.getCompression());
+    n.push_back(rhs.getMin());
+    n.push_back(rhs.getMax());
+    for (const auto &c : rhs.getCentroids()) {
+      n.push_back(c.mean);
+      n.push_back(c.weight);
+    }
+
+    return n;
+  }
+
+  static bool decode(const Node &n, sketch_t &rhs) {
+    if (!n.IsSequence() || n.size() < 3 || (n.size() - 3) % 2 != 0)
+      return false;
+
+    typename sketch_t::centroids_t centroids((n.size() - 3) / 2);
+    for (std::size_t i = 0; i < centroids.size(); ++i) {
+      centroids[i].mean = n[3 + 2 * i].as<T>();
+      centroids[i].weight = n[4 + 2 * i].as<T>();
+    }
+
+    rhs = sketch_t(n[0].as<std::size_t>(), n[1].as<T>(), n[2].as<T>(),
+                   centroids);
+    return true;
+  }
+};
+}  // namespace YAML
+
+#endif  // CSLIBS_MATH_SERIALIZATION_QUANTILE_SKETCH_HPP
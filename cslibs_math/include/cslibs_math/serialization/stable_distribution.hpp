@@ -92,7 +92,7 @@ struct convert<cslibs_math::statistics::StableDistribution<
     sample_t mean = rhs.getMean();
     for (std::size_t i = 0; i < Dim; ++i) n.push_back(mean(i));
 
-    covariance_t s = rhs.getS();
+    covariance_t s = rhs.getScatter();
     for (std::size_t i = 0; i < Dim; ++i)
       for (std::size_t j = 0; j < Dim; ++j) n.push_back(s(i, j));
 
@@ -128,7 +128,7 @@ struct convert<
     Node n;
     n.push_back(rhs.getN());
     n.push_back(rhs.getMean());
-    n.push_back(rhs.getSquared());
+    n.push_back(rhs.getScatter());
 
     return n;
   }
@@ -1,12 +1,83 @@
 #ifndef CSLIBS_MATH_ANGULAR_MEAN_HPP
 #define CSLIBS_MATH_ANGULAR_MEAN_HPP
 
+#include <complex>
 #include <cslibs_math/common/angle.hpp>
 #include <eigen3/Eigen/Core>
 #include <memory>
+#include <type_traits>
 
 namespace cslibs_math {
 namespace statistics {
+namespace detail {
+/// angles are buffered in blocks of this size for the batch evaluation
+constexpr Eigen::Index ANGLE_BLOCK_SIZE = 256;
+
+/// blocks are evaluated in double precision, Eigen's packet sin and cos for
+/// float are slower than the scalar functions on plain SSE2 targets
+template <typename T>
+using angle_block_t = Eigen::Array<
+    typename std::conditional<std::is_same<T, float>::value, double, T>::type,
+    ANGLE_BLOCK_SIZE, 1>;
+
+/**
+ * @brief Sum of the complex representations of the angles in [first,
+ *        last). cos and sin are evaluated on whole blocks, so Eigen's packet
+ *        math is used where it is available.
+ * @return the number of angles
+ */
+template <typename T, typename Iterator>
+inline std::size_t sumComplex(Iterator first, Iterator last,
+                              std::complex<T> &sum) {
+  angle_block_t<T> angles;
+  Eigen::Index k = 0;
+  std::size_t n = 0;
+  typename angle_block_t<T>::Scalar re = 0;
+  typename angle_block_t<T>::Scalar im = 0;
+  auto flush = [&angles, &k, &re, &im]() {
+    re += angles.head(k).cos().sum();
+    im += angles.head(k).sin().sum();
+    k = 0;
+  };
+  for (; first != last; ++first, ++n) {
+    angles(k++) = *first;
+    if (k == ANGLE_BLOCK_SIZE) flush();
+  }
+  flush();
+  sum = std::complex<T>(static_cast<T>(re), static_cast<T>(im));
+  return n;
+}
+
+/**
+ * @brief Weighted sum of the complex representations, see above.
+ * @return the sum of weights
+ */
+template <typename T, typename Iterator, typename WeightIterator>
+inline T sumComplex(Iterator first, Iterator last, WeightIterator weights_first,
+                    std::complex<T> &sum) {
+  angle_block_t<T> angles;
+  angle_block_t<T> weights;
+  Eigen::Index k = 0;
+  typename angle_block_t<T>::Scalar w = 0;
+  typename angle_block_t<T>::Scalar re = 0;
+  typename angle_block_t<T>::Scalar im = 0;
+  auto flush = [&angles, &weights, &k, &w, &re, &im]() {
+    w += weights.head(k).sum();
+    re += (weights.head(k) * angles.head(k).cos()).sum();
+    im += (weights.head(k) * angles.head(k).sin()).sum();
+    k = 0;
+  };
+  for (; first != last; ++first, ++weights_first) {
+    angles(k) = *first;
+    weights(k++) = *weights_first;
+    if (k == ANGLE_BLOCK_SIZE) flush();
+  }
+  flush();
+  sum = std::complex<T>(static_cast<T>(re), static_cast<T>(im));
+  return static_cast<T>(w);
+}
+}  // namespace detail
+
 template <typename T>
 class EIGEN_ALIGN16 AngularMean {
  public:
@@ -41,8 +112,28 @@ class EIGEN_ALIGN16 AngularMean {
     dirty_ = true;
   }
 
-  inline AngularMean &operator+=(const AngularMean &other) {
+  /**
+   * @brief Add all angles in [first, last). The complex representations
+   *        are summed in blocks and folded into the mean with a single
+   *        division.
+   */
+  template <typename Iterator>
+  inline void add(Iterator first, Iterator last) {
+    complex sum;
+    const std::size_t n = detail::sumComplex<T>(first, last, sum);
+    if (n == 0) return;
+
+    const std::size_t _n = n_1_ + n;
+    complex_mean_ =
+        (complex_mean_ * static_cast<T>(n_1_) + sum) / static_cast<T>(_n);
+    n_ = _n + 1;
+    n_1_ = _n;
     dirty_ = true;
+  }
+
+  inline AngularMean &operator+=(const AngularMean &other) {
+    if (other.n_1_ == 0) return *this;
+
     std::size_t _n = n_1_ + other.n_1_;
     complex_mean_ = (complex_mean_ * static_cast<T>(n_1_) +
                      other.complex_mean_ * static_cast<T>(other.n_1_)) /
@@ -53,6 +144,8 @@ class EIGEN_ALIGN16 AngularMean {
     return *this;
   }
 
+  inline void merge(const AngularMean &other) { *this += other; }
+
   inline T getN() const { return n_1_; }
 
   inline T getMean() const {
@@ -1,41 +1,203 @@
 #ifndef CSLIBS_MATH_BHATTACHARYYA_HPP
 #define CSLIBS_MATH_BHATTACHARYYA_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <cslibs_math/linear/cholesky.hpp>
 #include <cslibs_math/statistics/distribution.hpp>
 #include <cslibs_math/statistics/weighted_distribution.hpp>
+#include <limits>
+#include <thread>
+#include <vector>
 
 namespace cslibs_math {
 namespace statistics {
+namespace detail {
+/**
+ * @brief Logarithm of the determinant through the Cholesky factor, like the
+ *        cached one of the distributions, which does not underflow for
+ *        nearly singular covariances.
+ */
+template <typename T, std::size_t Dim>
+inline T logDeterminant(const Eigen::Matrix<T, Dim, Dim> &s,
+                        Eigen::Matrix<T, Dim, Dim> &s_inv) {
+  Eigen::Matrix<T, Dim, Dim> lower;
+  T determinant;
+  T log_determinant;
+  linear::Cholesky<T, Dim>::compute(s, lower, s_inv, determinant,
+                                    log_determinant);
+  return log_determinant;
+}
+
+template <typename T, std::size_t Dim>
+inline T logDeterminant(const Eigen::Matrix<T, Dim, Dim> &s) {
+  Eigen::Matrix<T, Dim, Dim> s_inv;
+  return logDeterminant<T, Dim>(s, s_inv);
+}
+
+/**
+ * @brief Bhattacharyya distance with the log-determinants of both
+ *        covariances given.
+ */
 template <typename T, std::size_t Dim>
 inline T bhattacharyya(const Eigen::Matrix<T, Dim, Dim> &s_a,
                        const Eigen::Matrix<T, Dim, 1> &m_a,
+                       const T log_det_sa,
                        const Eigen::Matrix<T, Dim, Dim> &s_b,
-                       const Eigen::Matrix<T, Dim, 1> &m_b) {
+                       const Eigen::Matrix<T, Dim, 1> &m_b,
+                       const T log_det_sb) {
   const Eigen::Matrix<T, Dim, 1> dm = (m_a - m_b);
   const Eigen::Matrix<T, Dim, Dim> s = (s_a + s_b) * 0.5;
-  const T det_sa = s_a.determinant();
-  const T det_sb = s_b.determinant();
-  const T det_s = s.determinant();
+  Eigen::Matrix<T, Dim, Dim> s_inv;
+  const T log_det_s = logDeterminant<T, Dim>(s, s_inv);
 
-  return 0.125 * static_cast<T>(Eigen::Matrix<T, 1, Dim>(dm.transpose()) *
-                                s.inverse() * dm) +
-         0.5 * std::log(det_s / std::sqrt(det_sa * det_sb));
+  return 0.125 * dm.dot(s_inv * dm) +
+         0.5 * (log_det_s - 0.5 * (log_det_sa + log_det_sb));
+}
+}  // namespace detail
+
+template <typename T, std::size_t Dim>
+inline T bhattacharyya(const Eigen::Matrix<T, Dim, Dim> &s_a,
+                       const Eigen::Matrix<T, Dim, 1> &m_a,
+                       const Eigen::Matrix<T, Dim, Dim> &s_b,
+                       const Eigen::Matrix<T, Dim, 1> &m_b) {
+  return detail::bhattacharyya<T, Dim>(
+      s_a, m_a, detail::logDeterminant<T, Dim>(s_a), s_b, m_b,
+      detail::logDeterminant<T, Dim>(s_b));
 }
 
 template <typename T, std::size_t Dim, std::size_t lamda_ratio_exponent = 0>
 inline T bhattacharyya(const Distribution<T, Dim, lamda_ratio_exponent> &a,
                        const Distribution<T, Dim, lamda_ratio_exponent> &b) {
-  return bhattacharyya<T, Dim, >(a.getCovariance(), a.getMean(),
-                                 b.getCovariance(), b.getMean());
+  return detail::bhattacharyya<T, Dim>(
+      a.getCovariance(), a.getMean(), a.getLogDeterminant(),
+      b.getCovariance(), b.getMean(), b.getLogDeterminant());
 }
 
 template <typename T, std::size_t Dim, std::size_t lamda_ratio_exponent = 0>
 inline T bhattacharyya(
     const WeightedDistribution<T, Dim, lamda_ratio_exponent> &a,
     const WeightedDistribution<T, Dim, lamda_ratio_exponent> &b) {
-  return bhattacharyya<T, Dim>(a.getCovariance(), a.getMean(),
-                               b.getCovariance(), b.getMean());
+  return detail::bhattacharyya<T, Dim>(
+      a.getCovariance(), a.getMean(), a.getLogDeterminant(),
+      b.getCovariance(), b.getMean(), b.getLogDeterminant());
 }
+
+/**
+ * @brief The BhattacharyyaMatrix class evaluates Bhattacharyya distances
+ *        between all pairs of a set of distributions. Means, covariances and
+ *        log-determinants are extracted once on construction, the pairwise
+ *        evaluation only reads this snapshot and runs on multiple threads.
+ *        Distances involving invalid distributions are +inf.
+ */
+template <typename T, std::size_t Dim>
+class BhattacharyyaMatrix {
+ public:
+  using sample_t = Eigen::Matrix<T, Dim, 1>;
+  using covariance_t = Eigen::Matrix<T, Dim, Dim>;
+  using matrix_t = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+
+  struct Neighbor {
+    std::size_t index;
+    T distance;
+  };
+  using neighbors_t = std::vector<std::vector<Neighbor>>;
+
+  /**
+   * @param distributions - container of Distribution or WeightedDistribution
+   */
+  template <typename Container>
+  inline explicit BhattacharyyaMatrix(const Container &distributions) {
+    for (const auto &d : distributions) {
+      const bool valid = d.valid();
+      valid_.emplace_back(valid);
+      means_.emplace_back(d.getMean());
+      covariances_.emplace_back(valid ? covariance_t(d.getCovariance())
+                                      : covariance_t::Zero());
+      log_determinants_.emplace_back(valid ? d.getLogDeterminant() : T());
+    }
+  }
+
+  inline std::size_t size() const { return valid_.size(); }
+
+  inline T distance(const std::size_t i, const std::size_t j) const {
+    if (!valid_[i] || !valid_[j]) return std::numeric_limits<T>::infinity();
+    return detail::bhattacharyya<T, Dim>(covariances_[i], means_[i],
+                                         log_determinants_[i],
+                                         covariances_[j], means_[j],
+                                         log_determinants_[j]);
+  }
+
+  /**
+   * @brief Dense symmetric distance matrix with zero diagonal.
+   * @param threads - number of threads, 0 uses the hardware concurrency
+   */
+  inline matrix_t dense(const std::size_t threads = 0) const {
+    const std::size_t n = size();
+    matrix_t distances = matrix_t::Zero(n, n);
+    /// every unordered pair is written by exactly one thread
+    forEachRow(threads, [this, n, &distances](const std::size_t i) {
+      for (std::size_t j = i + 1; j < n; ++j)
+        distances(i, j) = distances(j, i) = distance(i, j);
+    });
+    return distances;
+  }
+
+  /**
+   * @brief The k nearest valid neighbors of every distribution, sorted by
+   *        increasing distance, the distribution itself is excluded.
+   * @param k       - maximum number of neighbors
+   * @param threads - number of threads, 0 uses the hardware concurrency
+   */
+  inline neighbors_t nearest(const std::size_t k,
+                             const std::size_t threads = 0) const {
+    const std::size_t n = size();
+    neighbors_t neighbors(n);
+    forEachRow(threads, [this, n, k, &neighbors](const std::size_t i) {
+      if (!valid_[i]) return;
+
+      std::vector<Neighbor> &row = neighbors[i];
+      row.reserve(n);
+      for (std::size_t j = 0; j < n; ++j) {
+        if (j != i && valid_[j]) row.push_back(Neighbor{j, distance(i, j)});
+      }
+      auto closer = [](const Neighbor &a, const Neighbor &b) {
+        return a.distance < b.distance ||
+               (a.distance == b.distance && a.index < b.index);
+      };
+      const std::size_t m = std::min(k, row.size());
+      std::partial_sort(row.begin(), row.begin() + m, row.end(), closer);
+      row.resize(m);
+      row.shrink_to_fit();
+    });
+    return neighbors;
+  }
+
+ private:
+  std::vector<bool> valid_;
+  std::vector<sample_t, Eigen::aligned_allocator<sample_t>> means_;
+  std::vector<covariance_t, Eigen::aligned_allocator<covariance_t>>
+      covariances_;
+  std::vector<T> log_determinants_;
+
+  /// rows are interleaved between threads to balance the triangle
+  template <typename Function>
+  inline void forEachRow(std::size_t threads, Function function) const {
+    const std::size_t n = size();
+    if (threads == 0)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max<std::size_t>(1, std::min(threads, n));
+
+    auto rows = [n, threads, &function](const std::size_t t) {
+      for (std::size_t i = t; i < n; i += threads) function(i);
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) workers.emplace_back(rows, t);
+    rows(0);
+    for (auto &worker : workers) worker.join();
+  }
+};
 }  // namespace statistics
 }  // namespace cslibs_math
 
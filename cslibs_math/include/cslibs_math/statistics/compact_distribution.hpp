@@ -0,0 +1,249 @@
+#ifndef CSLIBS_MATH_COMPACT_DISTRIBUTION_HPP
+#define CSLIBS_MATH_COMPACT_DISTRIBUTION_HPP
+
+#include <cmath>
+#include <cslibs_math/linear/cholesky.hpp>
+#include <cslibs_math/linear/packed.hpp>
+#include <cslibs_math/linear/symmetric_eigen.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <cslibs_math/statistics/limit_eigen_values.hpp>
+#include <cslibs_math/statistics/stable_distribution.hpp>
+#include <eigen3/Eigen/Core>
+#include <limits>
+#include <memory>
+
+namespace cslibs_math {
+namespace statistics {
+/**
+ * @brief The CompactDistribution class only stores the sufficient statistics
+ *        of a multivariate normal distribution: sample count, mean and the
+ *        upper triangle of the scatter matrix, packed row-wise and updated
+ *        with Welford's algorithm. Members are unaligned, so no padding is
+ *        added, e.g. 80 bytes for Dim = 3 in double precision.
+ *        Derived quantities are not cached, they are computed on demand into
+ *        a Scratch provided by the caller, which can be reused for many
+ *        distributions.
+ */
+template <typename T, std::size_t Dim, std::size_t lambda_ratio_exponent = 0>
+class CompactDistribution {
+  static_assert(Dim > 1, "Use Distribution<T, 1> for univariate data.");
+
+ public:
+  using allocator_t =
+      std::allocator<CompactDistribution<T, Dim, lambda_ratio_exponent>>;
+
+  using Ptr =
+      std::shared_ptr<CompactDistribution<T, Dim, lambda_ratio_exponent>>;
+  static constexpr std::size_t PackedSize = Dim * (Dim + 1) / 2;
+
+  using sample_t = Eigen::Matrix<T, Dim, 1>;
+  using covariance_t = Eigen::Matrix<T, Dim, Dim>;
+  using eigen_values_t = Eigen::Matrix<T, Dim, 1>;
+  using eigen_vectors_t = Eigen::Matrix<T, Dim, Dim>;
+  using packed_t = Eigen::Matrix<T, PackedSize, 1, Eigen::DontAlign>;
+  using distribution_t = Distribution<T, Dim, lambda_ratio_exponent>;
+  using stable_distribution_t =
+      StableDistribution<T, Dim, lambda_ratio_exponent>;
+
+  static constexpr T log_sqrt_2_M_PI =
+      static_cast<T>(0.918938533204672741780329736406);
+
+  /**
+   * @brief The Scratch struct receives the derived quantities.
+   */
+  struct EIGEN_ALIGN16 Scratch {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    covariance_t covariance{covariance_t::Zero()};
+    covariance_t information_matrix{covariance_t::Zero()};
+    covariance_t cholesky{covariance_t::Zero()};
+    eigen_values_t eigen_values{eigen_values_t::Zero()};
+    eigen_vectors_t eigen_vectors{eigen_vectors_t::Zero()};
+    T determinant{0};
+    T log_determinant{0};
+  };
+
+  inline CompactDistribution() = default;
+
+  inline CompactDistribution(const std::size_t n, const sample_t &mean,
+                             const packed_t &scatter)
+      : n_{n}, mean_{mean}, scatter_{scatter} {}
+
+  inline explicit CompactDistribution(const stable_distribution_t &other)
+      : n_{other.getN()}, mean_{other.getMean()} {
+    pack(other.getScatter(), scatter_);
+  }
+
+  inline explicit CompactDistribution(const distribution_t &other)
+      : n_{other.getN()}, mean_{other.getMean()} {
+    /// scatter = n * (E[x x^T] - mean * mean^T)
+    const covariance_t correlated = other.getCorrelated();
+    const sample_t mean = mean_;
+    for (std::size_t i = 0; i < Dim; ++i) {
+      for (std::size_t j = i; j < Dim; ++j) {
+        scatter_(index(i, j)) = (correlated(i, j) - mean(i) * mean(j)) *
+                                static_cast<T>(n_);
+      }
+    }
+  }
+
+  inline CompactDistribution(const CompactDistribution &other) = default;
+  inline CompactDistribution &operator=(const CompactDistribution &other) =
+      default;
+
+  inline void reset() {
+    n_ = 0;
+    mean_.setZero();
+    scatter_.setZero();
+  }
+
+  /// Conversion
+  inline distribution_t toDistribution() const {
+    if (n_ == 0) return distribution_t();
+
+    const sample_t mean = mean_;
+    covariance_t correlated = covariance_t::Zero();
+    for (std::size_t i = 0; i < Dim; ++i) {
+      for (std::size_t j = i; j < Dim; ++j) {
+        correlated(i, j) = correlated(j, i) =
+            scatter_(index(i, j)) / static_cast<T>(n_) + mean(i) * mean(j);
+      }
+    }
+    return distribution_t(n_, mean, correlated);
+  }
+
+  inline stable_distribution_t toStableDistribution() const {
+    return stable_distribution_t(n_, getMean(), getScatter());
+  }
+
+  /// Modification
+  inline void add(const sample_t &p) {
+    const sample_t _mean = mean_;
+    const std::size_t _n = n_ + 1;
+    mean_ = (_mean * static_cast<T>(n_) + p) / static_cast<T>(_n);
+    const sample_t mean = mean_;
+    for (std::size_t i = 0; i < Dim; ++i) {
+      for (std::size_t j = i; j < Dim; ++j) {
+        scatter_(index(i, j)) += (p(i) - _mean(i)) * (p(j) - mean(j));
+      }
+    }
+    n_ = _n;
+  }
+
+  inline void add(const CompactDistribution &other) {
+    if (other.n_ == 0) return;
+
+    const std::size_t _n = n_ + other.n_;
+    const sample_t dmean = mean_ - other.mean_;
+    mean_ = (sample_t(mean_) * static_cast<T>(n_) +
+             sample_t(other.mean_) * static_cast<T>(other.n_)) /
+            static_cast<T>(_n);
+    const T scale = static_cast<T>(n_ * other.n_) / static_cast<T>(_n);
+    for (std::size_t i = 0; i < Dim; ++i) {
+      for (std::size_t j = i; j < Dim; ++j) {
+        scatter_(index(i, j)) +=
+            other.scatter_(index(i, j)) + scale * dmean(i) * dmean(j);
+      }
+    }
+    n_ = _n;
+  }
+
+  inline CompactDistribution &operator+=(const sample_t &p) {
+    add(p);
+    return *this;
+  }
+
+  inline CompactDistribution &operator+=(const CompactDistribution &other) {
+    add(other);
+    return *this;
+  }
+
+  inline void merge(const CompactDistribution &other) { add(other); }
+
+  /// Distribution properties
+  inline bool valid() const { return n_ > Dim; }
+
+  inline std::size_t getN() const { return n_; }
+
+  inline sample_t getMean() const { return mean_; }
+
+  inline packed_t const &getPackedScatter() const { return scatter_; }
+
+  inline covariance_t getScatter() const {
+    covariance_t scatter;
+    unpack(scatter_, scatter);
+    return scatter;
+  }
+
+  /**
+   * @brief Compute covariance, information matrix and determinants into the
+   *        scratch, optionally the eigen decomposition of the covariance as
+   *        well. The scratch is left untouched for invalid distributions.
+   * @return valid()
+   */
+  inline bool derive(Scratch &scratch, const bool eigen = false) const {
+    if (!valid()) return false;
+
+    unpack(packed_t(scatter_ / static_cast<T>(n_ - 1)), scratch.covariance);
+    LimitEigenValues<T, Dim, lambda_ratio_exponent>::apply(
+        scratch.covariance);
+    linear::Cholesky<T, Dim>::compute(
+        scratch.covariance, scratch.cholesky, scratch.information_matrix,
+        scratch.determinant, scratch.log_determinant);
+    if (eigen) {
+      linear::SymmetricEigen<T, Dim>::compute(
+          scratch.covariance, scratch.eigen_values, scratch.eigen_vectors);
+    }
+    return true;
+  }
+
+  /// Evaluation, scratch has to be derived from this distribution
+  inline T sample(const sample_t &p, const Scratch &scratch) const {
+    return valid() ? std::exp(logSample(p, scratch)) : T();
+  }
+
+  inline T sampleNonNormalized(const sample_t &p,
+                               const Scratch &scratch) const {
+    return valid() ? std::exp(exponent(p, scratch)) : T();
+  }
+
+  inline T logSample(const sample_t &p, const Scratch &scratch) const {
+    return valid() ? exponent(p, scratch) -
+                         (scratch.log_determinant + log_sqrt_2_M_PI)
+                   : -std::numeric_limits<T>::infinity();
+  }
+
+ private:
+  std::size_t n_{0};
+  Eigen::Matrix<T, Dim, 1, Eigen::DontAlign> mean_{
+      Eigen::Matrix<T, Dim, 1, Eigen::DontAlign>::Zero()};
+  packed_t scatter_{packed_t::Zero()};
+
+  /// the packed upper triangle shares its layout with DistributionArray
+  inline static constexpr std::size_t index(const std::size_t i,
+                                            const std::size_t j) {
+    return linear::packed<Dim>(i, j);
+  }
+
+  inline static void pack(const covariance_t &matrix, packed_t &packed) {
+    for (std::size_t i = 0; i < Dim; ++i) {
+      for (std::size_t j = i; j < Dim; ++j) packed(index(i, j)) = matrix(i, j);
+    }
+  }
+
+  inline static void unpack(const packed_t &packed, covariance_t &matrix) {
+    for (std::size_t i = 0; i < Dim; ++i) {
+      for (std::size_t j = i; j < Dim; ++j)
+        matrix(i, j) = matrix(j, i) = packed(index(i, j));
+    }
+  }
+
+  inline T exponent(const sample_t &p, const Scratch &scratch) const {
+    const sample_t q = p - getMean();
+    return T(-0.5) * q.dot(scratch.information_matrix * q);
+  }
+};
+}  // namespace statistics
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_COMPACT_DISTRIBUTION_HPP
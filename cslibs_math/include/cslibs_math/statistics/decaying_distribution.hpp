@@ -0,0 +1,124 @@
+#ifndef CSLIBS_MATH_DECAYING_DISTRIBUTION_HPP
+#define CSLIBS_MATH_DECAYING_DISTRIBUTION_HPP
+
+#include <cmath>
+#include <cslibs_math/statistics/weighted_distribution.hpp>
+#include <memory>
+#include <type_traits>
+
+namespace cslibs_math {
+namespace statistics {
+/**
+ * @brief The DecayClock class is the global epoch counter shared by all
+ *        DecayingDistributions of a map. Advancing it is O(1), the cells are
+ *        aged lazily when they are touched next.
+ */
+template <typename T>
+class DecayClock {
+ public:
+  /**
+   * @param factor - forgetting factor in (0, 1] applied per epoch
+   */
+  inline explicit DecayClock(const T factor) : factor_{factor} {}
+
+  inline void step() { ++epoch_; }
+
+  inline std::size_t getEpoch() const { return epoch_; }
+
+  inline T getFactor() const { return factor_; }
+
+  /**
+   * @brief Accumulated forgetting factor since the given epoch.
+   */
+  inline T decay(const std::size_t since) const {
+    return since >= epoch_ ? T(1)
+                           : std::pow(factor_, static_cast<T>(epoch_ - since));
+  }
+
+ private:
+  T factor_;
+  std::size_t epoch_ = 0;
+};
+
+/**
+ * @brief The DecayingDistribution class is a WeightedDistribution with
+ *        exponential forgetting. The accumulated weights are scaled by the
+ *        forgetting factor of the clock for every epoch passed since the
+ *        distribution was touched last, so new evidence keeps moving the
+ *        estimate in long-running maps. Cells whose weight underflows are
+ *        reset.
+ */
+template <typename T, std::size_t Dim, std::size_t lambda_ratio_exponent = 0>
+class EIGEN_ALIGN16 DecayingDistribution {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  using allocator_t = Eigen::aligned_allocator<
+      DecayingDistribution<T, Dim, lambda_ratio_exponent>>;
+
+  using Ptr =
+      std::shared_ptr<DecayingDistribution<T, Dim, lambda_ratio_exponent>>;
+  using distribution_t = WeightedDistribution<T, Dim, lambda_ratio_exponent>;
+  using decay_clock_t = DecayClock<T>;
+  using sample_t =
+      typename std::conditional<Dim == 1, T, Eigen::Matrix<T, Dim, 1>>::type;
+
+  inline DecayingDistribution() = default;
+
+  inline void reset() {
+    distribution_.reset();
+    epoch_ = 0;
+  }
+
+  /// Modification
+  inline void add(const sample_t &p, const decay_clock_t &clock,
+                  const T w = static_cast<T>(1.0)) {
+    decay(clock);
+    distribution_.add(p, w);
+  }
+
+  inline void merge(const DecayingDistribution &other,
+                    const decay_clock_t &clock) {
+    decay(clock);
+    DecayingDistribution decayed(other);
+    decayed.decay(clock);
+    if (decayed.distribution_.getWeight() > T())
+      distribution_ += decayed.distribution_;
+  }
+
+  /**
+   * @brief Apply the forgetting of all epochs passed since the last touch.
+   */
+  inline void decay(const decay_clock_t &clock) {
+    const std::size_t epoch = clock.getEpoch();
+    if (epoch_ >= epoch) return;
+
+    distribution_.scale(clock.decay(epoch_));
+    if (distribution_.getWeight() <= T()) distribution_.reset();
+    epoch_ = epoch;
+  }
+
+  /// Distribution access
+  /**
+   * @brief The distribution as of the last touch. Mean and covariance do
+   *        not change by forgetting, only the weights do.
+   */
+  inline const distribution_t &getDistribution() const {
+    return distribution_;
+  }
+
+  inline T getWeight(const decay_clock_t &clock) const {
+    return distribution_.getWeight() * clock.decay(epoch_);
+  }
+
+  inline std::size_t getEpoch() const { return epoch_; }
+
+  inline bool valid() const { return distribution_.valid(); }
+
+ private:
+  distribution_t distribution_;
+  std::size_t epoch_ = 0;
+};
+}  // namespace statistics
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_DECAYING_DISTRIBUTION_HPP
@@ -7,8 +7,12 @@
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Eigen>
 #include <iostream>
+#include <limits>
 
 #include <cslibs_math/statistics/limit_eigen_values.hpp>
+#include <cslibs_math/linear/symmetric_eigen.hpp>
+#include <cslibs_math/linear/cholesky.hpp>
+#include <cslibs_math/linear/mahalanobis.hpp>
 #include <cslibs_math/approx/sqrt.hpp>
 
 namespace cslibs_math {
@@ -25,8 +29,85 @@ public:
     using covariance_t        = Eigen::Matrix<T, Dim, Dim>;
     using eigen_values_t      = Eigen::Matrix<T, Dim, 1>;
     using eigen_vectors_t     = Eigen::Matrix<T, Dim, Dim>;
+    using samples_t           = Eigen::Matrix<T, Dim, Eigen::Dynamic>;
+    using densities_t         = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+    static constexpr T sqrt_2_M_PI     = static_cast<T>(cslibs_math::approx::sqrt(2.0 * M_PI));
+    static constexpr T log_sqrt_2_M_PI = static_cast<T>(0.918938533204672741780329736406);
+
+    /**
+     * @brief Immutable snapshot of a distribution for evaluation. All values
+     *        are precomputed on construction, no method writes any state,
+     *        therefore an Evaluator can be shared between threads without
+     *        synchronization. Create it via Distribution::freeze().
+     */
+    class EIGEN_ALIGN16 Evaluator {
+    public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        using allocator_t = Eigen::aligned_allocator<Evaluator>;
+
+        inline Evaluator() :
+            mean_(sample_t::Zero()),
+            information_matrix_(covariance_t::Zero()),
+            denominator_(T()),
+            log_denominator_(-std::numeric_limits<T>::infinity()),
+            valid_(false)
+        {
+        }
+
+        inline bool valid() const
+        {
+            return valid_;
+        }
+
+        inline sample_t const & getMean() const
+        {
+            return mean_;
+        }
+
+        inline covariance_t const & getInformationMatrix() const
+        {
+            return information_matrix_;
+        }
+
+        inline T denominator() const
+        {
+            return denominator_;
+        }
+
+        inline T sample(const sample_t &p) const
+        {
+            return valid_ ? denominator_ * std::exp(exponent(p)) : T();
+        }
 
-    static constexpr T sqrt_2_M_PI = static_cast<T>(cslibs_math::approx::sqrt(2.0 * M_PI));
+        inline T sampleNonNormalized(const sample_t &p) const
+        {
+            return valid_ ? std::exp(exponent(p)) : T();
+        }
+
+        /**
+         * @brief Natural logarithm of sample(p), -inf for invalid distributions.
+         */
+        inline T logLikelihood(const sample_t &p) const
+        {
+            return valid_ ? log_denominator_ + exponent(p) : -std::numeric_limits<T>::infinity();
+        }
+
+    private:
+        friend class Distribution;
+
+        sample_t     mean_;
+        covariance_t information_matrix_;
+        T            denominator_;
+        T            log_denominator_;
+        bool         valid_;
+
+        inline T exponent(const sample_t &p) const
+        {
+            const sample_t q = p - mean_;
+            return static_cast<T>(-0.5) * q.dot(information_matrix_ * q);
+        }
+    };
 
     inline Distribution() :
         mean_(sample_t::Zero()),
@@ -37,6 +118,7 @@ public:
         eigen_values_(eigen_values_t::Zero()),
         eigen_vectors_(eigen_vectors_t::Zero()),
         determinant_(T()),  // zero initialization
+        log_determinant_(T()),
         dirty_(false),
         dirty_eigenvalues_(false)
     {
@@ -54,6 +136,7 @@ public:
         eigen_values_(eigen_values_t::Zero()),
         eigen_vectors_(eigen_vectors_t::Zero()),
         determinant_(T()),
+        log_determinant_(T()),
         dirty_(true),
         dirty_eigenvalues_(true)
     {
@@ -68,6 +151,7 @@ public:
         eigen_values_(other.eigen_values_),
         eigen_vectors_(other.eigen_vectors_),
         determinant_(other.determinant_),
+        log_determinant_(other.log_determinant_),
         dirty_(other.dirty_),
         dirty_eigenvalues_(other.dirty_eigenvalues_)
     {
@@ -84,6 +168,7 @@ public:
         eigen_values_         = other.eigen_values_;
         eigen_vectors_        = other.eigen_vectors_;
         determinant_          = other.determinant_;
+        log_determinant_      = other.log_determinant_;
 
         dirty_                = other.dirty_;
         dirty_eigenvalues_    = other.dirty_eigenvalues_;
@@ -101,6 +186,7 @@ public:
         eigen_values_         = std::move(other.eigen_values_);
         eigen_vectors_        = std::move(other.eigen_vectors_);
         determinant_          = other.determinant_;
+        log_determinant_      = other.log_determinant_;
 
         dirty_                = other.dirty_;
         dirty_eigenvalues_    = other.dirty_eigenvalues_;
@@ -117,6 +203,7 @@ public:
         eigen_values_         = std::move(other.eigen_values_);
         eigen_vectors_        = std::move(other.eigen_vectors_);
         determinant_          = other.determinant_;
+        log_determinant_      = other.log_determinant_;
 
         dirty_                = other.dirty_;
         dirty_eigenvalues_    = other.dirty_eigenvalues_;
@@ -134,6 +221,7 @@ public:
         eigen_vectors_      = eigen_vectors_t::Zero();
         eigen_values_       = eigen_values_t::Zero();
         determinant_        = T();
+        log_determinant_    = T();
 
         dirty_              = true;
         dirty_eigenvalues_  = true;
@@ -154,6 +242,40 @@ public:
         dirty_eigenvalues_ = true;
     }
 
+    /**
+     * @brief Add a batch of samples. Raw sums are accumulated over the whole
+     *        batch and folded into mean and correlated matrix once.
+     * @param first - iterator to the first sample
+     * @param last  - iterator past the last sample
+     */
+    template <typename Iterator>
+    inline void add(Iterator first, Iterator last)
+    {
+        sample_t     sum        = sample_t::Zero();
+        covariance_t correlated = covariance_t::Zero();
+        std::size_t  n = 0;
+        for (; first != last; ++first, ++n) {
+            accumulate(*first, sum, correlated);
+        }
+        fold(n, sum, correlated);
+    }
+
+    /**
+     * @brief Add a batch of samples given column-wise. This is a template so
+     *        that Eigen expressions still select add(const sample_t&).
+     * @param samples - Dim x N matrix
+     */
+    template <int Cols>
+    inline void add(const Eigen::Matrix<T, Dim, Cols> &samples)
+    {
+        sample_t     sum        = sample_t::Zero();
+        covariance_t correlated = covariance_t::Zero();
+        for (Eigen::Index c = 0 ; c < samples.cols() ; ++c) {
+            accumulate(samples.col(c), sum, correlated);
+        }
+        fold(static_cast<std::size_t>(samples.cols()), sum, correlated);
+    }
+
     inline Distribution& operator += (const sample_t &p)
     {
         add(p);
@@ -171,6 +293,56 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Remove a sample which has been added before, inverse of add(p).
+     *        Removing the last sample resets the distribution.
+     */
+    inline void remove(const sample_t &p)
+    {
+        if (n_ <= 1) {
+            reset();
+            return;
+        }
+
+        const std::size_t _n = n_ - 1;
+        mean_ = (mean_ * static_cast<T>(n_) - p) / static_cast<T>(_n);
+        for (std::size_t i = 0 ; i < Dim ; ++i) {
+            for (std::size_t j = i ; j < Dim ; ++j) {
+                correlated_(i, j) = (correlated_(i, j) * static_cast<T>(n_) - p(i) * p(j)) / static_cast<T>(_n);
+            }
+        }
+        n_ = _n;
+        dirty_ = true;
+        dirty_eigenvalues_ = true;
+    }
+
+    inline Distribution& operator -= (const sample_t &p)
+    {
+        remove(p);
+        return *this;
+    }
+
+    /**
+     * @brief Remove a distribution which has been merged before, inverse of
+     *        operator +=. Raw moments cancel badly if most samples are
+     *        removed, StableDistribution is the better choice for that.
+     */
+    inline Distribution& operator -= (const Distribution &other)
+    {
+        if (other.n_ >= n_) {
+            reset();
+            return *this;
+        }
+
+        const std::size_t _n = n_ - other.n_;
+        mean_       = (mean_ * static_cast<T>(n_) - other.mean_ * static_cast<T>(other.n_)) / static_cast<T>(_n);
+        correlated_ = (correlated_ * static_cast<T>(n_) - other.correlated_ * static_cast<T>(other.n_)) / static_cast<T>(_n);
+        n_          = _n;
+        dirty_      = true;
+        dirty_eigenvalues_ = true;
+        return *this;
+    }
+
     inline bool valid() const
     {
         return n_ > Dim;
@@ -217,6 +389,18 @@ public:
         covariance = (dirty_ && valid()) ? update_return_covariance() : covariance_t(covariance_);
     }
 
+    /**
+     * @brief Logarithm of the covariance determinant, summed from the
+     *        Cholesky factor, so it stays finite for small covariances.
+     */
+    inline T getLogDeterminant() const
+    {
+        auto update_return_log_determinant = [this](){
+            update(); return log_determinant_;
+        };
+        return (dirty_ && valid()) ? update_return_log_determinant() : log_determinant_;
+    }
+
     inline covariance_t getInformationMatrix() const
     {
         auto update_return_information = [this](){
@@ -334,6 +518,118 @@ public:
         return sampleNonNormalized(getMean());
     }
 
+    /**
+     * @brief Natural logarithm of sample(p), computed without the exp/log
+     *        round trip, -inf for invalid distributions.
+     */
+    inline T logSample(const sample_t &p) const
+    {
+        auto update_sample = [this, &p]() {
+            if (dirty_) update();
+            const sample_t q = p - mean_;
+            return static_cast<T>(-0.5) * q.dot(information_matrix_ * q) - (log_determinant_ + log_sqrt_2_M_PI);
+        };
+        return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+    }
+
+    /**
+     * @brief Natural logarithm of sampleNonNormalized(p), -inf for invalid
+     *        distributions.
+     */
+    inline T logSampleNonNormalized(const sample_t &p) const
+    {
+        auto update_sample = [this, &p]() {
+            if (dirty_) update();
+            const sample_t q = p - mean_;
+            return static_cast<T>(-0.5) * q.dot(information_matrix_ * q);
+        };
+        return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+    }
+
+    /**
+     * @brief Batch evaluation, the points are given column-wise and the
+     *        results are written to out, one entry per point. The cached
+     *        values are updated once for the whole batch.
+     *        mahalanobis yields the squared Mahalanobis distances, +inf for
+     *        invalid distributions.
+     */
+    inline void mahalanobis(const samples_t &points,
+                            densities_t &out) const
+    {
+        if (!valid()) {
+            out.setConstant(points.cols(), std::numeric_limits<T>::infinity());
+            return;
+        }
+        if (dirty_)
+            update();
+        linear::Mahalanobis<T, Dim>::squared(mean_, information_matrix_, points, out);
+    }
+
+    inline void sample(const samples_t &points,
+                       densities_t &out) const
+    {
+        if (!valid()) {
+            out.setZero(points.cols());
+            return;
+        }
+        mahalanobis(points, out);
+        out = (static_cast<T>(-0.5) * out).exp() * (static_cast<T>(1.0) / (determinant_ * sqrt_2_M_PI));
+    }
+
+    inline void sampleNonNormalized(const samples_t &points,
+                                    densities_t &out) const
+    {
+        if (!valid()) {
+            out.setZero(points.cols());
+            return;
+        }
+        mahalanobis(points, out);
+        out = (static_cast<T>(-0.5) * out).exp();
+    }
+
+    inline void logSample(const samples_t &points,
+                          densities_t &out) const
+    {
+        if (!valid()) {
+            out.setConstant(points.cols(), -std::numeric_limits<T>::infinity());
+            return;
+        }
+        mahalanobis(points, out);
+        out = static_cast<T>(-0.5) * out - (log_determinant_ + log_sqrt_2_M_PI);
+    }
+
+    inline void logSampleNonNormalized(const samples_t &points,
+                                       densities_t &out) const
+    {
+        if (!valid()) {
+            out.setConstant(points.cols(), -std::numeric_limits<T>::infinity());
+            return;
+        }
+        mahalanobis(points, out);
+        out *= static_cast<T>(-0.5);
+    }
+
+    /**
+     * @brief Snapshot of the current state for concurrent evaluation. This
+     *        updates the cached values and therefore must not run concurrently
+     *        with other calls on this distribution.
+     */
+    inline Evaluator freeze() const
+    {
+        Evaluator e;
+        if (!valid())
+            return e;
+        if (dirty_)
+            update();
+
+        e.mean_               = mean_;
+        e.information_matrix_ = information_matrix_;
+        e.denominator_        = static_cast<T>(1.0) / (determinant_ * sqrt_2_M_PI);
+        e.log_denominator_    = -(log_determinant_ + log_sqrt_2_M_PI);
+        e.valid_              = true;
+        return e;
+    }
+
     inline void merge(const Distribution &other)
     {
         *this += other;
@@ -349,10 +645,43 @@ private:
     mutable eigen_values_t       eigen_values_;
     mutable eigen_vectors_t      eigen_vectors_;
     mutable T                    determinant_;
+    mutable T                    log_determinant_;
 
     mutable bool                 dirty_;
     mutable bool                 dirty_eigenvalues_;
 
+    inline static void accumulate(const sample_t &p,
+                                  sample_t &sum,
+                                  covariance_t &correlated)
+    {
+        sum += p;
+        for (std::size_t i = 0 ; i < Dim ; ++i) {
+            for (std::size_t j = i ; j < Dim ; ++j) {
+                correlated(i, j) += p(i) * p(j);
+            }
+        }
+    }
+
+    inline void fold(const std::size_t n,
+                     const sample_t &sum,
+                     const covariance_t &correlated)
+    {
+        if (n == 0)
+            return;
+
+        const std::size_t _n = n_ + n;
+        const T scale = static_cast<T>(1) / static_cast<T>(_n);
+        mean_ = (mean_ * static_cast<T>(n_) + sum) * scale;
+        for (std::size_t i = 0 ; i < Dim ; ++i) {
+            for (std::size_t j = i ; j < Dim ; ++j) {
+                correlated_(i, j) = (correlated_(i, j) * static_cast<T>(n_) + correlated(i, j)) * scale;
+            }
+        }
+        n_ = _n;
+        dirty_ = true;
+        dirty_eigenvalues_ = true;
+    }
+
     inline void update() const
     {
         const T scale = static_cast<T>(n_) / static_cast<T>(n_ - 1);
@@ -365,8 +694,9 @@ private:
 
         LimitEigenValues<T, Dim, lambda_ratio_exponent>::apply(covariance_);
 
-        information_matrix_ = covariance_.inverse();
-        determinant_        = covariance_.determinant();
+        covariance_t cholesky;
+        linear::Cholesky<T, Dim>::compute(covariance_, cholesky, information_matrix_,
+                                          determinant_, log_determinant_);
 
         dirty_              = false;
     }
@@ -376,10 +706,7 @@ private:
         if (dirty_)
             update();
 
-        Eigen::EigenSolver<covariance_t> solver;
-        solver.compute(covariance_);
-        eigen_vectors_ = solver.eigenvectors().real();
-        eigen_values_  = solver.eigenvalues().real();
+        linear::SymmetricEigen<T, Dim>::compute(covariance_, eigen_values_, eigen_vectors_);
 
         dirty_eigenvalues_ = false;
     }
@@ -393,7 +720,64 @@ public:
     using allocator_t = Eigen::aligned_allocator<Distribution<T, 1, lambda_ratio_exponent>>;
     using Ptr         = std::shared_ptr<Distribution<T, 1, lambda_ratio_exponent>>;
 
-    static constexpr T sqrt_2_M_PI = cslibs_math::approx::sqrt(2.0 * M_PI);
+    static constexpr T sqrt_2_M_PI     = cslibs_math::approx::sqrt(2.0 * M_PI);
+    static constexpr T log_sqrt_2_M_PI = static_cast<T>(0.918938533204672741780329736406);
+
+    /**
+     * @brief Immutable snapshot for lock-free evaluation, see the
+     *        multi-dimensional Distribution::Evaluator.
+     */
+    class Evaluator {
+    public:
+        inline Evaluator() :
+            mean_(T()),
+            scale_(T()),
+            denominator_(T()),
+            log_denominator_(-std::numeric_limits<T>::infinity()),
+            valid_(false)
+        {
+        }
+
+        inline bool valid() const
+        {
+            return valid_;
+        }
+
+        inline T getMean() const
+        {
+            return mean_;
+        }
+
+        inline T sample(const T s) const
+        {
+            return valid_ ? denominator_ * std::exp(exponent(s)) : T();
+        }
+
+        inline T sampleNonNormalized(const T s) const
+        {
+            return valid_ ? std::exp(exponent(s)) : T();
+        }
+
+        inline T logLikelihood(const T s) const
+        {
+            return valid_ ? log_denominator_ + exponent(s) : -std::numeric_limits<T>::infinity();
+        }
+
+    private:
+        friend class Distribution;
+
+        T    mean_;
+        T    scale_;
+        T    denominator_;
+        T    log_denominator_;
+        bool valid_;
+
+        inline T exponent(const T s) const
+        {
+            const T x = s - mean_;
+            return -x * x * scale_;
+        }
+    };
 
     inline Distribution() :
         mean_(T()),
@@ -401,6 +785,7 @@ public:
         n_(0),
         variance_(T()),
         standard_deviation_(T()),
+        log_standard_deviation_(T()),
         dirty_(false)
     {
     }
@@ -414,6 +799,7 @@ public:
         n_(n),
         variance_(T()),
         standard_deviation_(T()),
+        log_standard_deviation_(T()),
         dirty_(true)
     {
     }
@@ -429,6 +815,7 @@ public:
         n_                  = 0;
         variance_           = T();
         standard_deviation_ = T();
+        log_standard_deviation_ = T();
         dirty_              = false;
     }
 
@@ -457,6 +844,41 @@ public:
         return *this;
     }
 
+    inline void remove(const T s)
+    {
+        if (n_ <= 1) {
+            reset();
+            return;
+        }
+
+        const std::size_t _n = n_ - 1;
+        mean_    = (mean_ * static_cast<T>(n_) - s) / static_cast<T>(_n);
+        squared_ = (squared_ * static_cast<T>(n_) - s*s) / static_cast<T>(_n);
+        n_       = _n;
+        dirty_   = true;
+    }
+
+    inline Distribution & operator -= (const T s)
+    {
+        remove(s);
+        return *this;
+    }
+
+    inline Distribution & operator -= (const Distribution &other)
+    {
+        if (other.n_ >= n_) {
+            reset();
+            return *this;
+        }
+
+        const std::size_t _n = n_ - other.n_;
+        mean_    = (mean_ * static_cast<T>(n_) - other.mean_ * static_cast<T>(other.n_)) / static_cast<T>(_n);
+        squared_ = (squared_ * static_cast<T>(n_) - other.squared_ * static_cast<T>(other.n_)) / static_cast<T>(_n);
+        n_       = _n;
+        dirty_   = true;
+        return *this;
+    }
+
     inline bool valid() const
     {
         return n_ > 1;
@@ -515,6 +937,48 @@ public:
         return valid() ? update_sample() : T();
     }
 
+    inline T logSample(const T s) const
+    {
+        auto update_sample = [this, &s]() {
+            if (dirty_) update();
+            const T d = 2.0 * variance_;
+            const T x = s - mean_;
+            return -0.5 * x * x / d - (log_sqrt_2_M_PI + log_standard_deviation_);
+        };
+        return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+    }
+
+    inline T logSampleNonNormalized(const T s) const
+    {
+        auto update_sample = [this, &s]() {
+            if (dirty_) update();
+            const T d = 2.0 * variance_;
+            const T x = s - mean_;
+            return -0.5 * x * x / d;
+        };
+        return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+    }
+
+    /**
+     * @brief Snapshot of the current state for concurrent evaluation, must
+     *        not run concurrently with other calls on this distribution.
+     */
+    inline Evaluator freeze() const
+    {
+        Evaluator e;
+        if (!valid())
+            return e;
+        if (dirty_)
+            update();
+
+        e.mean_            = mean_;
+        e.scale_           = 0.5 / (2.0 * variance_);
+        e.denominator_     = 1.0 / (sqrt_2_M_PI * standard_deviation_);
+        e.log_denominator_ = -(log_sqrt_2_M_PI + log_standard_deviation_);
+        e.valid_           = true;
+        return e;
+    }
+
     inline void merge(const Distribution &other)
     {
         *this += other;
@@ -527,6 +991,7 @@ private:
 
     mutable T       variance_;
     mutable T       standard_deviation_;
+    mutable T       log_standard_deviation_;
 
     mutable bool    dirty_;
 
@@ -535,6 +1000,7 @@ private:
         const T scale = static_cast<T>(n_) / static_cast<T>(n_ - 1);
         variance_ = (squared_ - mean_ * mean_) * scale;
         standard_deviation_ = std::sqrt(variance_);
+        log_standard_deviation_ = static_cast<T>(0.5) * std::log(variance_);
         dirty_ = false;
     }
 };
@@ -0,0 +1,427 @@
+#ifndef CSLIBS_MATH_DISTRIBUTION_ARRAY_HPP
+#define CSLIBS_MATH_DISTRIBUTION_ARRAY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cslibs_math/linear/cholesky.hpp>
+#include <cslibs_math/linear/packed.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <vector>
+
+namespace cslibs_math {
+namespace statistics {
+namespace detail {
+/**
+ * @brief Column-wise inversion of packed symmetric matrices. The generic
+ *        version is not vectorizable and is used for Dim > 3 only, it goes
+ *        through linear::Cholesky like Distribution::update().
+ */
+template <typename T, std::size_t Dim>
+struct PackedInverse {
+  static constexpr std::size_t Triangle = Dim * (Dim + 1) / 2;
+  using column_t = std::vector<T>;
+  using matrix_t = Eigen::Matrix<T, Dim, Dim>;
+
+  inline static void apply(const std::size_t size,
+                           const std::array<column_t, Triangle> &matrix,
+                           std::array<column_t, Triangle> &inverse,
+                           column_t &determinant) {
+    for (std::size_t c = 0; c < size; ++c) {
+      matrix_t m;
+      for (std::size_t i = 0; i < Dim; ++i) {
+        for (std::size_t j = i; j < Dim; ++j) {
+          m(i, j) = matrix[linear::packed<Dim>(i, j)][c];
+          m(j, i) = m(i, j);
+        }
+      }
+      matrix_t lower;
+      matrix_t inv;
+      T det;
+      T log_det;
+      linear::Cholesky<T, Dim>::compute(m, lower, inv, det, log_det);
+      if (det == T()) inv.setZero();
+      for (std::size_t i = 0; i < Dim; ++i)
+        for (std::size_t j = i; j < Dim; ++j)
+          inverse[linear::packed<Dim>(i, j)][c] = inv(i, j);
+      determinant[c] = det;
+    }
+  }
+};
+
+template <typename T>
+struct PackedInverse<T, 2> {
+  using column_t = std::vector<T>;
+
+  inline static void apply(const std::size_t size,
+                           const std::array<column_t, 3> &matrix,
+                           std::array<column_t, 3> &inverse,
+                           column_t &determinant) {
+    const T *a00 = matrix[0].data();
+    const T *a01 = matrix[1].data();
+    const T *a11 = matrix[2].data();
+    T *i00 = inverse[0].data();
+    T *i01 = inverse[1].data();
+    T *i11 = inverse[2].data();
+    T *det = determinant.data();
+
+    for (std::size_t c = 0; c < size; ++c) {
+      const T d = a00[c] * a11[c] - a01[c] * a01[c];
+      const T s = d != T() ? T(1) / d : T();
+      i00[c] = a11[c] * s;
+      i01[c] = -a01[c] * s;
+      i11[c] = a00[c] * s;
+      det[c] = d;
+    }
+  }
+};
+
+template <typename T>
+struct PackedInverse<T, 3> {
+  using column_t = std::vector<T>;
+
+  inline static void apply(const std::size_t size,
+                           const std::array<column_t, 6> &matrix,
+                           std::array<column_t, 6> &inverse,
+                           column_t &determinant) {
+    const T *a00 = matrix[0].data();
+    const T *a01 = matrix[1].data();
+    const T *a02 = matrix[2].data();
+    const T *a11 = matrix[3].data();
+    const T *a12 = matrix[4].data();
+    const T *a22 = matrix[5].data();
+    T *i00 = inverse[0].data();
+    T *i01 = inverse[1].data();
+    T *i02 = inverse[2].data();
+    T *i11 = inverse[3].data();
+    T *i12 = inverse[4].data();
+    T *i22 = inverse[5].data();
+    T *det = determinant.data();
+
+    for (std::size_t c = 0; c < size; ++c) {
+      /// cofactors, the matrix is symmetric so is its adjugate
+      const T c00 = a11[c] * a22[c] - a12[c] * a12[c];
+      const T c01 = a02[c] * a12[c] - a01[c] * a22[c];
+      const T c02 = a01[c] * a12[c] - a02[c] * a11[c];
+      const T c11 = a00[c] * a22[c] - a02[c] * a02[c];
+      const T c12 = a01[c] * a02[c] - a00[c] * a12[c];
+      const T c22 = a00[c] * a11[c] - a01[c] * a01[c];
+      const T d = a00[c] * c00 + a01[c] * c01 + a02[c] * c02;
+      const T s = d != T() ? T(1) / d : T();
+      i00[c] = c00 * s;
+      i01[c] = c01 * s;
+      i02[c] = c02 * s;
+      i11[c] = c11 * s;
+      i12[c] = c12 * s;
+      i22[c] = c22 * s;
+      det[c] = d;
+    }
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief The DistributionArray class stores a large number of distributions
+ *        as a structure of arrays. Only the accumulators (n, mean and the
+ *        upper triangle of the correlated matrix) are state, each one is
+ *        kept in its own contiguous column. Covariance, information matrix
+ *        and determinant are derived lazily, either per cell on access or
+ *        for all cells at once with updateAll().
+ *        Results are equal to the ones of Distribution<T, Dim>.
+ */
+template <typename T, std::size_t Dim, std::size_t lambda_ratio_exponent = 0>
+class DistributionArray {
+ public:
+  static_assert(Dim > 1, "Use a column of Distribution<T, 1> instead.");
+
+  using Ptr =
+      std::shared_ptr<DistributionArray<T, Dim, lambda_ratio_exponent>>;
+  using distribution_t = Distribution<T, Dim, lambda_ratio_exponent>;
+  using sample_t = typename distribution_t::sample_t;
+  using covariance_t = typename distribution_t::covariance_t;
+  using column_t = std::vector<T>;
+
+  static constexpr std::size_t Triangle = Dim * (Dim + 1) / 2;
+  static constexpr T sqrt_2_M_PI = distribution_t::sqrt_2_M_PI;
+
+  inline DistributionArray() = default;
+
+  inline explicit DistributionArray(const std::size_t size) { resize(size); }
+
+  inline DistributionArray(const DistributionArray &other) = default;
+  inline DistributionArray(DistributionArray &&other) = default;
+  inline DistributionArray &operator=(const DistributionArray &other) =
+      default;
+  inline DistributionArray &operator=(DistributionArray &&other) = default;
+
+  inline std::size_t size() const { return n_.size(); }
+
+  inline void resize(const std::size_t size) {
+    n_.resize(size, 0);
+    for (auto &c : mean_) c.resize(size, T());
+    for (auto &c : correlated_) c.resize(size, T());
+    for (auto &c : covariance_) c.resize(size, T());
+    for (auto &c : information_matrix_) c.resize(size, T());
+    determinant_.resize(size, T());
+    dirty_.resize(size, 1);
+    dirty_any_ = true;
+  }
+
+  /// Modification
+  inline void reset(const std::size_t i) {
+    n_[i] = 0;
+    for (auto &c : mean_) c[i] = T();
+    for (auto &c : correlated_) c[i] = T();
+    markDirty(i);
+  }
+
+  inline void reset() {
+    std::fill(n_.begin(), n_.end(), 0);
+    for (auto &c : mean_) std::fill(c.begin(), c.end(), T());
+    for (auto &c : correlated_) std::fill(c.begin(), c.end(), T());
+    std::fill(dirty_.begin(), dirty_.end(), 1);
+    dirty_any_ = true;
+  }
+
+  inline void add(const std::size_t i, const sample_t &p) {
+    const std::size_t n = n_[i];
+    const std::size_t _n = n + 1;
+    const T scale = T(1) / static_cast<T>(_n);
+    for (std::size_t k = 0; k < Dim; ++k) {
+      mean_[k][i] = (mean_[k][i] * static_cast<T>(n) + p(k)) * scale;
+    }
+    for (std::size_t k = 0; k < Dim; ++k) {
+      for (std::size_t l = k; l < Dim; ++l) {
+        T &c = correlated_[linear::packed<Dim>(k, l)][i];
+        c = (c * static_cast<T>(n) + p(k) * p(l)) * scale;
+      }
+    }
+    n_[i] = _n;
+    markDirty(i);
+  }
+
+  inline void merge(const std::size_t i, const std::size_t other_n,
+                    const sample_t &other_mean,
+                    const covariance_t &other_correlated) {
+    const std::size_t n = n_[i];
+    const std::size_t _n = n + other_n;
+    if (_n == 0) return;
+
+    const T wa = static_cast<T>(n) / static_cast<T>(_n);
+    const T wb = static_cast<T>(other_n) / static_cast<T>(_n);
+    for (std::size_t k = 0; k < Dim; ++k) {
+      mean_[k][i] = mean_[k][i] * wa + other_mean(k) * wb;
+    }
+    for (std::size_t k = 0; k < Dim; ++k) {
+      for (std::size_t l = k; l < Dim; ++l) {
+        T &c = correlated_[linear::packed<Dim>(k, l)][i];
+        c = c * wa + other_correlated(k, l) * wb;
+      }
+    }
+    n_[i] = _n;
+    markDirty(i);
+  }
+
+  inline void merge(const std::size_t i, const distribution_t &other) {
+    merge(i, other.getN(), other.getMean(), other.getCorrelated());
+  }
+
+  inline void merge(const std::size_t i, const DistributionArray &other,
+                    const std::size_t j) {
+    merge(i, other.getN(j), other.getMean(j), other.getCorrelated(j));
+  }
+
+  inline void set(const std::size_t i, const distribution_t &d) {
+    reset(i);
+    merge(i, d);
+  }
+
+  /// Distribution properties
+  inline bool valid(const std::size_t i) const { return n_[i] > Dim; }
+
+  inline std::size_t getN(const std::size_t i) const { return n_[i]; }
+
+  inline sample_t getMean(const std::size_t i) const {
+    sample_t mean;
+    for (std::size_t k = 0; k < Dim; ++k) mean(k) = mean_[k][i];
+    return mean;
+  }
+
+  inline covariance_t getCorrelated(const std::size_t i) const {
+    return unpack(correlated_, i);
+  }
+
+  inline covariance_t getCovariance(const std::size_t i) const {
+    if (dirty_[i] && valid(i)) update(i);
+    return unpack(covariance_, i);
+  }
+
+  inline covariance_t getInformationMatrix(const std::size_t i) const {
+    if (dirty_[i] && valid(i)) update(i);
+    return unpack(information_matrix_, i);
+  }
+
+  inline distribution_t getDistribution(const std::size_t i) const {
+    return n_[i] > 0
+               ? distribution_t(n_[i], getMean(i), getCorrelated(i))
+               : distribution_t();
+  }
+
+  /**
+   * @brief Accumulator columns, n is stored per cell, mean per dimension and
+   *        the correlated matrix per packed upper triangle entry.
+   */
+  inline std::vector<std::size_t> const &getNColumn() const { return n_; }
+
+  inline column_t const &getMeanColumn(const std::size_t k) const {
+    return mean_[k];
+  }
+
+  inline column_t const &getCorrelatedColumn(const std::size_t k,
+                                             const std::size_t l) const {
+    return correlated_[linear::packed<Dim>(std::min(k, l), std::max(k, l))];
+  }
+
+  /// Evaluation
+  /**
+   * @brief Derive covariance, information matrix and determinant of all
+   *        cells at once. Each step is a single pass over contiguous columns
+   *        and is vectorized by the compiler for Dim = 2 and Dim = 3.
+   */
+  inline void updateAll() const {
+    if (!dirty_any_) return;
+
+    const std::size_t size = n_.size();
+    column_t scale(size);
+    for (std::size_t c = 0; c < size; ++c) {
+      const T n = static_cast<T>(n_[c]);
+      scale[c] = n_[c] > 1 ? n / (n - T(1)) : T();
+    }
+
+    for (std::size_t k = 0; k < Dim; ++k) {
+      const T *mk = mean_[k].data();
+      for (std::size_t l = k; l < Dim; ++l) {
+        const std::size_t p = linear::packed<Dim>(k, l);
+        const T *ml = mean_[l].data();
+        const T *corr = correlated_[p].data();
+        const T *s = scale.data();
+        T *cov = covariance_[p].data();
+        for (std::size_t c = 0; c < size; ++c) {
+          cov[c] = (corr[c] - mk[c] * ml[c]) * s[c];
+        }
+      }
+    }
+
+    if (lambda_ratio_exponent != 0) {
+      for (std::size_t c = 0; c < size; ++c) {
+        if (!valid(c)) continue;
+        covariance_t cov = unpack(covariance_, c);
+        LimitEigenValues<T, Dim, lambda_ratio_exponent>::apply(cov);
+        pack(cov, covariance_, c);
+      }
+    }
+
+    detail::PackedInverse<T, Dim>::apply(size, covariance_,
+                                         information_matrix_, determinant_);
+
+    std::fill(dirty_.begin(), dirty_.end(), 0);
+    dirty_any_ = false;
+  }
+
+  inline T denominator(const std::size_t i) const {
+    if (!valid(i)) return T();
+    if (dirty_[i]) update(i);
+    return 1.0 / (determinant_[i] * sqrt_2_M_PI);
+  }
+
+  inline T sample(const std::size_t i, const sample_t &p) const {
+    if (!valid(i)) return T();
+    if (dirty_[i]) update(i);
+    return std::exp(exponent(i, p)) / (determinant_[i] * sqrt_2_M_PI);
+  }
+
+  inline T sampleNonNormalized(const std::size_t i, const sample_t &p) const {
+    if (!valid(i)) return T();
+    if (dirty_[i]) update(i);
+    return std::exp(exponent(i, p));
+  }
+
+ private:
+  std::vector<std::size_t> n_;
+  std::array<column_t, Dim> mean_;
+  std::array<column_t, Triangle> correlated_;
+
+  mutable std::array<column_t, Triangle> covariance_;
+  mutable std::array<column_t, Triangle> information_matrix_;
+  mutable column_t determinant_;
+
+  mutable std::vector<char> dirty_;
+  mutable bool dirty_any_{false};
+
+  inline void markDirty(const std::size_t i) {
+    dirty_[i] = 1;
+    dirty_any_ = true;
+  }
+
+  inline static covariance_t unpack(
+      const std::array<column_t, Triangle> &columns, const std::size_t i) {
+    covariance_t m;
+    for (std::size_t k = 0; k < Dim; ++k) {
+      for (std::size_t l = k; l < Dim; ++l) {
+        m(k, l) = columns[linear::packed<Dim>(k, l)][i];
+        m(l, k) = m(k, l);
+      }
+    }
+    return m;
+  }
+
+  inline static void pack(const covariance_t &m,
+                          std::array<column_t, Triangle> &columns,
+                          const std::size_t i) {
+    for (std::size_t k = 0; k < Dim; ++k)
+      for (std::size_t l = k; l < Dim; ++l)
+        columns[linear::packed<Dim>(k, l)][i] = m(k, l);
+  }
+
+  inline T exponent(const std::size_t i, const sample_t &p) const {
+    const sample_t q = p - getMean(i);
+    T e = T();
+    for (std::size_t k = 0; k < Dim; ++k) {
+      e += information_matrix_[linear::packed<Dim>(k, k)][i] * q(k) * q(k);
+      for (std::size_t l = k + 1; l < Dim; ++l) {
+        e += T(2) * information_matrix_[linear::packed<Dim>(k, l)][i] * q(k) *
+             q(l);
+      }
+    }
+    return -0.5 * e;
+  }
+
+  inline void update(const std::size_t i) const {
+    const T n = static_cast<T>(n_[i]);
+    const T scale = n / (n - T(1));
+    covariance_t cov;
+    for (std::size_t k = 0; k < Dim; ++k) {
+      for (std::size_t l = k; l < Dim; ++l) {
+        cov(k, l) = (correlated_[linear::packed<Dim>(k, l)][i] -
+                     mean_[k][i] * mean_[l][i]) *
+                    scale;
+        cov(l, k) = cov(k, l);
+      }
+    }
+
+    LimitEigenValues<T, Dim, lambda_ratio_exponent>::apply(cov);
+
+    covariance_t lower;
+    covariance_t inverse;
+    T log_determinant;
+    linear::Cholesky<T, Dim>::compute(cov, lower, inverse, determinant_[i],
+                                      log_determinant);
+
+    pack(cov, covariance_, i);
+    pack(inverse, information_matrix_, i);
+    dirty_[i] = 0;
+  }
+};
+}  // namespace statistics
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_DISTRIBUTION_ARRAY_HPP
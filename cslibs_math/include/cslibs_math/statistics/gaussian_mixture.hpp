@@ -0,0 +1,335 @@
+#ifndef CSLIBS_MATH_GAUSSIAN_MIXTURE_HPP
+#define CSLIBS_MATH_GAUSSIAN_MIXTURE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cslibs_math/statistics/bhattacharyya.hpp>
+#include <cslibs_math/statistics/parallel_accumulate.hpp>
+#include <cslibs_math/statistics/weighted_distribution.hpp>
+#include <eigen3/Eigen/Core>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace cslibs_math {
+namespace statistics {
+/**
+ * @brief The GaussianMixture class fits a mixture of WeightedDistributions
+ *        to a sample set by expectation maximization. The samples are
+ *        processed in blocks on multiple threads: the E-step evaluates the
+ *        log-densities of all components for a block and normalizes the
+ *        responsibilities in the log domain, the M-step feeds them as
+ *        weights into the batch accumulators of per-thread components,
+ *        which are merged pairwise afterwards. The responsibilities are never
+ *        stored for the whole sample set.
+ *        The mixture weights are the accumulated weights of the components,
+ *        components which become invalid are dropped.
+ */
+template <typename T, std::size_t Dim, std::size_t lambda_ratio_exponent = 0>
+class GaussianMixture {
+  static_assert(Dim > 1, "GaussianMixture requires multivariate samples.");
+
+ public:
+  using allocator_t =
+      std::allocator<GaussianMixture<T, Dim, lambda_ratio_exponent>>;
+
+  using Ptr = std::shared_ptr<GaussianMixture<T, Dim, lambda_ratio_exponent>>;
+  using distribution_t = WeightedDistribution<T, Dim, lambda_ratio_exponent>;
+  using distributions_t =
+      std::vector<distribution_t, typename distribution_t::allocator_t>;
+  using sample_t = Eigen::Matrix<T, Dim, 1>;
+  using samples_t = Eigen::Matrix<T, Dim, Eigen::Dynamic>;
+  using weights_t = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+  using densities_t = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+  inline GaussianMixture() = default;
+
+  /**
+   * @param components - the mixture weights are their accumulated weights
+   */
+  inline explicit GaussianMixture(const distributions_t &components)
+      : components_(components) {
+    refresh();
+  }
+
+  inline void reset() {
+    components_.clear();
+    log_weights_.resize(0);
+    log_likelihood_ = -std::numeric_limits<T>::infinity();
+  }
+
+  /// Fitting
+  /**
+   * @brief Initialize k components by assigning every sample to the nearest
+   *        of k seeds, which are evenly spaced samples. Seeds which attract
+   *        too few samples are dropped.
+   * @param samples - Dim x N matrix
+   * @param k       - number of components
+   * @param threads - number of threads, 0 uses the hardware concurrency
+   */
+  inline void initialize(const samples_t &samples, const std::size_t k,
+                         const std::size_t threads = 0) {
+    reset();
+    const Eigen::Index n = samples.cols();
+    const Eigen::Index seeds_count =
+        std::min<Eigen::Index>(static_cast<Eigen::Index>(k), n);
+    if (seeds_count == 0) return;
+
+    samples_t seeds(Dim, seeds_count);
+    for (Eigen::Index i = 0; i < seeds_count; ++i)
+      seeds.col(i) = samples.col(i * n / seeds_count);
+
+    auto assign = [&seeds](const samples_t &block, responsibilities_t &r) {
+      r.setZero(seeds.cols(), block.cols());
+      for (Eigen::Index i = 0; i < block.cols(); ++i) {
+        Eigen::Index nearest = 0;
+        (seeds.colwise() - block.col(i)).colwise().squaredNorm().minCoeff(
+            &nearest);
+        r(nearest, i) = T(1);
+      }
+      return T();
+    };
+    components_ = accumulate(samples, seeds_count, threads, assign).components;
+    refresh();
+  }
+
+  /**
+   * @brief Run EM iterations until the mean log-likelihood per sample
+   *        improves by less than the tolerance. Initializes a single
+   *        component if the mixture is empty.
+   * @param samples    - Dim x N matrix
+   * @param iterations - maximum number of iterations
+   * @param tolerance  - convergence threshold of the mean log-likelihood
+   * @param threads    - number of threads, 0 uses the hardware concurrency
+   * @return the number of iterations performed
+   */
+  inline std::size_t fit(const samples_t &samples,
+                         const std::size_t iterations = 100,
+                         const T tolerance = static_cast<T>(1e-6),
+                         const std::size_t threads = 0) {
+    if (samples.cols() == 0) return 0;
+    if (components_.empty()) initialize(samples, 1, threads);
+
+    auto expect = [this](const samples_t &block, responsibilities_t &r) {
+      return logResponsibilities(block, r);
+    };
+    T previous = -std::numeric_limits<T>::infinity();
+    std::size_t i = 0;
+    while (i < iterations && !components_.empty()) {
+      Step step = accumulate(samples, size(), threads, expect);
+      components_ = std::move(step.components);
+      refresh();
+      ++i;
+
+      /// the likelihood of the parameters the E-step was evaluated with
+      log_likelihood_ = step.log_likelihood / static_cast<T>(samples.cols());
+      if (log_likelihood_ - previous < tolerance) break;
+      previous = log_likelihood_;
+    }
+    return i;
+  }
+
+  /**
+   * @brief Greedily merge the closest pair of components while their
+   *        Bhattacharyya distance is below the threshold.
+   * @return the number of merges performed
+   */
+  inline std::size_t mergeComponents(const T max_distance) {
+    std::size_t merges = 0;
+    while (components_.size() > 1) {
+      const BhattacharyyaMatrix<T, Dim> distances(components_);
+      std::size_t a = 0;
+      std::size_t b = 0;
+      T closest = max_distance;
+      for (std::size_t i = 0; i < size(); ++i) {
+        for (std::size_t j = i + 1; j < size(); ++j) {
+          const T d = distances.distance(i, j);
+          if (d < closest) {
+            closest = d;
+            a = i;
+            b = j;
+          }
+        }
+      }
+      if (a == b) break;
+
+      components_[a] += components_[b];
+      components_.erase(components_.begin() + static_cast<std::ptrdiff_t>(b));
+      ++merges;
+    }
+    refresh();
+    return merges;
+  }
+
+  /// Mixture properties
+  inline std::size_t size() const { return components_.size(); }
+
+  inline bool empty() const { return components_.empty(); }
+
+  inline distributions_t const &getComponents() const { return components_; }
+
+  inline distribution_t const &getComponent(const std::size_t k) const {
+    return components_[k];
+  }
+
+  inline T getWeight(const std::size_t k) const {
+    return std::exp(log_weights_(static_cast<Eigen::Index>(k)));
+  }
+
+  inline weights_t getWeights() const { return log_weights_.array().exp(); }
+
+  /**
+   * @brief Mean log-likelihood per sample of the last EM iteration.
+   */
+  inline T getLogLikelihood() const { return log_likelihood_; }
+
+  /// Evaluation
+  inline T sample(const sample_t &p) const {
+    return empty() ? T() : std::exp(logSample(p));
+  }
+
+  inline T logSample(const sample_t &p) const {
+    if (empty()) return -std::numeric_limits<T>::infinity();
+
+    responsibilities_t r;
+    return logResponsibilities(samples_t(p), r);
+  }
+
+  /**
+   * @brief Batch evaluation, the points are given column-wise and the
+   *        results are written to out, one entry per point.
+   */
+  inline void sample(const samples_t &points, densities_t &out) const {
+    logSample(points, out);
+    out = empty() ? densities_t::Zero(points.cols()) : densities_t(out.exp());
+  }
+
+  inline void logSample(const samples_t &points, densities_t &out) const {
+    out.resize(points.cols());
+    if (empty()) {
+      out.setConstant(-std::numeric_limits<T>::infinity());
+      return;
+    }
+    responsibilities_t r;
+    for (Eigen::Index i = 0; i < points.cols(); i += BLOCK_SIZE) {
+      const Eigen::Index n = std::min(BLOCK_SIZE, points.cols() - i);
+      densities_t block_out;
+      logDensities(points.middleCols(i, n), r, block_out);
+      out.segment(i, n) = block_out;
+    }
+  }
+
+ private:
+  using responsibilities_t = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+
+  static constexpr Eigen::Index BLOCK_SIZE = 256;
+
+  /**
+   * @brief Per-thread partial result of one pass over the samples.
+   */
+  struct Step {
+    distributions_t components;
+    T log_likelihood{0};
+
+    inline Step &operator+=(const Step &other) {
+      for (std::size_t k = 0; k < other.components.size(); ++k) {
+        if (other.components[k].getWeight() > T())
+          components[k] += other.components[k];
+      }
+      log_likelihood += other.log_likelihood;
+      return *this;
+    }
+  };
+
+  distributions_t components_;
+  weights_t log_weights_;
+  T log_likelihood_{-std::numeric_limits<T>::infinity()};
+
+  /// drops invalid components and updates the cached values of the others,
+  /// afterwards evaluation does not write any state and can run in parallel
+  inline void refresh() {
+    components_.erase(
+        std::remove_if(components_.begin(), components_.end(),
+                       [](const distribution_t &d) { return !d.valid(); }),
+        components_.end());
+
+    T total = T();
+    for (const distribution_t &d : components_) total += d.getWeight();
+    log_weights_.resize(static_cast<Eigen::Index>(size()));
+    for (std::size_t k = 0; k < size(); ++k) {
+      components_[k].getInformationMatrix();
+      log_weights_(static_cast<Eigen::Index>(k)) =
+          std::log(components_[k].getWeight() / total);
+    }
+  }
+
+  /**
+   * @brief Log-density of the mixture per sample. The densities of the
+   *        weighted components are written to r, one row per component,
+   *        relative to the largest one of each sample, so they do not
+   *        underflow.
+   */
+  template <typename Block>
+  inline void logDensities(const Eigen::MatrixBase<Block> &block,
+                           responsibilities_t &r, densities_t &out) const {
+    const samples_t points = block;
+    r.resize(static_cast<Eigen::Index>(size()), points.cols());
+    densities_t log_densities;
+    for (std::size_t k = 0; k < size(); ++k) {
+      const Eigen::Index row = static_cast<Eigen::Index>(k);
+      components_[k].logSample(points, log_densities);
+      r.row(row) = log_densities.matrix().transpose().array() +
+                   log_weights_(row);
+    }
+    /// log-sum-exp over the components, shifted by the maximum
+    const Eigen::Array<T, 1, Eigen::Dynamic> max = r.colwise().maxCoeff();
+    r = (r.array().rowwise() - max).exp();
+    out = (max + r.colwise().sum().array().log()).transpose();
+  }
+
+  /**
+   * @brief Responsibilities of the components for the samples of a block.
+   * @return the log-likelihood of the block
+   */
+  inline T logResponsibilities(const samples_t &block,
+                               responsibilities_t &r) const {
+    densities_t log_likelihoods;
+    logDensities(block, r, log_likelihoods);
+    r.array().rowwise() /= r.array().colwise().sum();
+    return log_likelihoods.sum();
+  }
+
+  /**
+   * @brief Accumulate the samples into k components, weighted by the
+   *        responsibilities the given callable assigns to every block.
+   */
+  template <typename Responsibilities>
+  inline Step accumulate(const samples_t &samples, const std::size_t k,
+                         const std::size_t threads,
+                         Responsibilities responsibilities) const {
+    std::vector<Eigen::Index> blocks;
+    for (Eigen::Index i = 0; i < samples.cols(); i += BLOCK_SIZE)
+      blocks.emplace_back(i);
+
+    auto add = [&samples, &responsibilities, k](Step &step,
+                                                const Eigen::Index first) {
+      if (step.components.empty()) step.components.resize(k);
+
+      const Eigen::Index n = std::min(BLOCK_SIZE, samples.cols() - first);
+      const samples_t block = samples.middleCols(first, n);
+      responsibilities_t r;
+      step.log_likelihood += responsibilities(block, r);
+      for (std::size_t c = 0; c < k; ++c) {
+        step.components[c].add(
+            block, weights_t(r.row(static_cast<Eigen::Index>(c)).transpose()));
+      }
+    };
+    Step step = parallelAccumulate<Step>(blocks, threads, add);
+    step.components.resize(k);
+    return step;
+  }
+};
+}  // namespace statistics
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_GAUSSIAN_MIXTURE_HPP
@@ -0,0 +1,176 @@
+#ifndef CSLIBS_MATH_HISTOGRAM_HPP
+#define CSLIBS_MATH_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <assert.h>
+#include <eigen3/Eigen/Core>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace cslibs_math {
+namespace statistics {
+/**
+ * @brief The Histogram class counts values in equally sized bins over
+ *        [min, max). Values below min or from max on are counted as
+ *        underflow or overflow. Batches are binned in blocks, the bin
+ *        indices are computed with Eigen's packet math.
+ */
+template <typename T>
+class Histogram {
+ public:
+  using allocator_t = std::allocator<Histogram<T>>;
+
+  using Ptr = std::shared_ptr<Histogram<T>>;
+  using values_t = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+  using counts_t = std::vector<std::size_t>;
+
+  inline Histogram() : Histogram(T(0), T(1), 1) {}
+
+  /**
+   * @param min  - lower bound of the first bin
+   * @param max  - upper bound of the last bin
+   * @param bins - number of bins
+   */
+  inline Histogram(const T min, const T max, const std::size_t bins)
+      : min_{min}, max_{max}, counts_(bins + 2, 0ul) {
+    assert(bins > 0);
+    assert(max > min);
+    scale_ = static_cast<T>(bins) / (max_ - min_);
+  }
+
+  /**
+   * @param counts - underflow, bin counts, overflow
+   */
+  inline Histogram(const T min, const T max, const counts_t &counts)
+      : min_{min}, max_{max}, counts_(counts) {
+    assert(counts.size() > 2);
+    assert(max > min);
+    scale_ = static_cast<T>(getBins()) / (max_ - min_);
+    for (const std::size_t c : counts_) n_ += c;
+  }
+
+  inline void reset() {
+    std::fill(counts_.begin(), counts_.end(), 0ul);
+    n_ = 0;
+  }
+
+  /// Modification
+  inline void add(const T value) {
+    ++counts_[slot(value)];
+    ++n_;
+  }
+
+  template <typename Iterator>
+  inline void add(Iterator first, Iterator last) {
+    Eigen::Array<T, BLOCK_SIZE, 1> values;
+    Eigen::Index k = 0;
+    for (; first != last; ++first) {
+      values(k++) = *first;
+      if (k == BLOCK_SIZE) {
+        addBlock(values.head(k));
+        k = 0;
+      }
+    }
+    addBlock(values.head(k));
+  }
+
+  inline void add(const values_t &values) {
+    for (Eigen::Index i = 0; i < values.size(); i += BLOCK_SIZE)
+      addBlock(values.array().segment(
+          i, std::min<Eigen::Index>(BLOCK_SIZE, values.size() - i)));
+  }
+
+  /**
+   * @brief Merge another histogram, the binning has to be the same.
+   * @throws std::invalid_argument if the binning differs
+   */
+  inline Histogram &operator+=(const Histogram &other) {
+    if (min_ != other.min_ || max_ != other.max_ ||
+        counts_.size() != other.counts_.size())
+      throw std::invalid_argument("Histograms with different binning.");
+    for (std::size_t i = 0; i < counts_.size(); ++i)
+      counts_[i] += other.counts_[i];
+    n_ += other.n_;
+    return *this;
+  }
+
+  inline void merge(const Histogram &other) { *this += other; }
+
+  /// Histogram properties
+  inline std::size_t getN() const { return n_; }
+
+  inline std::size_t getBins() const { return counts_.size() - 2; }
+
+  inline T getMin() const { return min_; }
+
+  inline T getMax() const { return max_; }
+
+  inline T getBinWidth() const { return (max_ - min_) / getBins(); }
+
+  inline std::size_t getCount(const std::size_t bin) const {
+    return counts_[bin + 1];
+  }
+
+  inline std::size_t getUnderflow() const { return counts_.front(); }
+
+  inline std::size_t getOverflow() const { return counts_.back(); }
+
+  /**
+   * @brief Underflow, bin counts and overflow.
+   */
+  inline counts_t const &getCounts() const { return counts_; }
+
+  /**
+   * @brief Quantile interpolated linearly within the bins, clamped to
+   *        [min, max].
+   */
+  inline T getQuantile(const T q) const {
+    const T target = q * static_cast<T>(n_);
+    T cumulative = static_cast<T>(getUnderflow());
+    if (n_ == 0 || target <= cumulative) return min_;
+
+    const T width = getBinWidth();
+    for (std::size_t i = 0; i < getBins(); ++i) {
+      const T count = static_cast<T>(getCount(i));
+      if (cumulative + count >= target && count > T())
+        return min_ + width * (i + (target - cumulative) / count);
+      cumulative += count;
+    }
+    return max_;
+  }
+
+ private:
+  static constexpr Eigen::Index BLOCK_SIZE = 256;
+
+  T min_;
+  T max_;
+  T scale_;
+  counts_t counts_;
+  std::size_t n_{0};
+
+  /// slot 0 is the underflow, slot bins + 1 the overflow, clamped before
+  /// the conversion like addBlock, so that infinite values are counted too
+  inline std::size_t slot(const T value) const {
+    const T x = (value - min_) * scale_ + T(1);
+    return static_cast<std::size_t>(
+        std::min(std::max(T(0), x), static_cast<T>(counts_.size() - 1)));
+  }
+
+  template <typename Block>
+  inline void addBlock(const Eigen::ArrayBase<Block> &values) {
+    const T last = static_cast<T>(counts_.size() - 1);
+    /// shifted by one bin, so truncation maps everything below min to 0
+    const Eigen::Array<int, Eigen::Dynamic, 1, 0, BLOCK_SIZE, 1> slots =
+        ((values - min_) * scale_ + T(1))
+            .max(T(0))
+            .min(last)
+            .template cast<int>();
+    for (Eigen::Index i = 0; i < slots.size(); ++i) ++counts_[slots(i)];
+    n_ += static_cast<std::size_t>(values.size());
+  }
+};
+}  // namespace statistics
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_HISTOGRAM_HPP
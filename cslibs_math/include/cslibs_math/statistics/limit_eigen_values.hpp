@@ -1,6 +1,7 @@
 #ifndef CSLIBS_MATH_LIMIT_COVARIANCE_HPP
 #define CSLIBS_MATH_LIMIT_COVARIANCE_HPP
 
+#include <cslibs_math/linear/symmetric_eigen.hpp>
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Eigen>
 
@@ -32,19 +33,18 @@ struct LimitEigenValues {
   using eigen_vectors_t = Eigen::Matrix<T, Dim, Dim>;
 
   inline static void apply(matrix_t &matrix_io) {
-    Eigen::EigenSolver<matrix_t> solver;
-    solver.compute(matrix_io);
-    const auto eigen_values = solver.eigenvalues().real();
-    const auto eigen_vectors = solver.eigenvectors().real();
+    eigen_values_t eigen_values;
+    eigen_vectors_t eigen_vectors;
+    linear::SymmetricEigen<T, Dim>::compute(matrix_io, eigen_values,
+                                            eigen_vectors);
 
     const T lambda = lambda_ratio * eigen_values.maxCoeff();
-    matrix_t Lambda = matrix_t::Zero();
     for (std::size_t i = 0; i < Dim; ++i) {
-      Lambda(i, i) = std::abs(eigen_values(i)) < std::abs(lambda)
-                         ? lambda
-                         : eigen_values(i);
+      if (std::abs(eigen_values(i)) < std::abs(lambda))
+        eigen_values(i) = lambda;
     }
-    matrix_io = eigen_vectors * Lambda * (eigen_vectors.transpose()).format();
+    matrix_io = eigen_vectors * eigen_values.asDiagonal() *
+                eigen_vectors.transpose();
   }
 };
 
@@ -64,16 +64,14 @@ struct LimitEigenValuesByZero {
   using eigen_vectors_t = Eigen::Matrix<T, Dim, Dim>;
 
   inline static void apply(matrix_t &matrix_io) {
-    Eigen::EigenSolver<matrix_t> solver;
-    solver.compute(matrix_io);
-    const auto eigen_values = solver.eigenvalues().real();
-    const auto eigen_vectors = solver.eigenvectors().real();
+    eigen_values_t eigen_values;
+    eigen_vectors_t eigen_vectors;
+    linear::SymmetricEigen<T, Dim>::compute(matrix_io, eigen_values,
+                                            eigen_vectors);
 
-    matrix_t Lambda = matrix_t::Zero();
-    for (std::size_t i = 0; i < Dim; ++i) {
-      Lambda(i, i) = std::max(eigen_values(i), T());  // T() = zero
-    }
-    matrix_io = eigen_vectors * Lambda * eigen_vectors.transpose();
+    eigen_values = eigen_values.cwiseMax(T());  // T() = zero
+    matrix_io = eigen_vectors * eigen_values.asDiagonal() *
+                eigen_vectors.transpose();
   }
 };
 }  // namespace statistics
@@ -0,0 +1,95 @@
+#ifndef CSLIBS_MATH_PARALLEL_ACCUMULATE_HPP
+#define CSLIBS_MATH_PARALLEL_ACCUMULATE_HPP
+
+#include <algorithm>
+#include <eigen3/Eigen/Core>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace cslibs_math {
+namespace statistics {
+namespace detail {
+struct AddSample {
+  template <typename Accumulator, typename Sample>
+  inline void operator()(Accumulator &accumulator, const Sample &sample) const {
+    accumulator.add(sample);
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief Accumulate the samples in [first, last) into a statistics object,
+ *        e.g. a Distribution, using multiple threads. The range is split into
+ *        contiguous chunks, one per thread, each thread accumulates its own
+ *        partial result. The partials are merged pairwise (0 += 1, 2 += 3,
+ *        then 0 += 2, ...) via operator+=, so the result only depends on the
+ *        range and the thread count, not on scheduling.
+ *        The calling thread processes the first chunk itself, at most one
+ *        thread per sample is used.
+ * @param first   - random access iterator to the first sample
+ * @param last    - random access iterator past the last sample
+ * @param threads - number of threads, 0 uses the hardware concurrency
+ * @param add     - callable add(Accumulator&, const value_type&), defaults
+ *                  to accumulator.add(sample)
+ * @return the accumulated statistics
+ */
+template <typename Accumulator, typename Iterator,
+          typename AddFunction = detail::AddSample>
+inline Accumulator parallelAccumulate(Iterator first, Iterator last,
+                                      std::size_t threads = 0,
+                                      AddFunction add = AddFunction()) {
+  const std::size_t size =
+      static_cast<std::size_t>(std::distance(first, last));
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, size);
+  if (threads <= 1) {
+    Accumulator accumulator;
+    for (; first != last; ++first) add(accumulator, *first);
+    return accumulator;
+  }
+
+  std::vector<Accumulator, Eigen::aligned_allocator<Accumulator>> partials(
+      threads);
+  auto accumulate = [&partials, &add, first, size, threads](
+                        const std::size_t i) {
+    const Iterator begin = first + static_cast<std::ptrdiff_t>(size * i /
+                                                               threads);
+    const Iterator end = first + static_cast<std::ptrdiff_t>(
+                                     size * (i + 1) / threads);
+    Accumulator &accumulator = partials[i];
+    for (Iterator it = begin; it != end; ++it) add(accumulator, *it);
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (std::size_t i = 1; i < threads; ++i)
+    workers.emplace_back(accumulate, i);
+  accumulate(0);
+  for (auto &worker : workers) worker.join();
+
+  /// the number of partials is bounded by the thread count, reducing them
+  /// on the calling thread is cheap compared to the accumulation
+  for (std::size_t step = 1; step < threads; step *= 2) {
+    for (std::size_t i = 0; i + step < threads; i += 2 * step)
+      partials[i] += partials[i + step];
+  }
+  return partials.front();
+}
+
+/**
+ * @brief Convenience overload for containers, see above.
+ */
+template <typename Accumulator, typename Range,
+          typename AddFunction = detail::AddSample>
+inline Accumulator parallelAccumulate(const Range &range,
+                                      const std::size_t threads = 0,
+                                      AddFunction add = AddFunction()) {
+  return parallelAccumulate<Accumulator>(std::begin(range), std::end(range),
+                                         threads, add);
+}
+}  // namespace statistics
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_PARALLEL_ACCUMULATE_HPP
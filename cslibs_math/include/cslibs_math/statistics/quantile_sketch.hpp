@@ -0,0 +1,197 @@
+#ifndef CSLIBS_MATH_QUANTILE_SKETCH_HPP
+#define CSLIBS_MATH_QUANTILE_SKETCH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace cslibs_math {
+namespace statistics {
+/**
+ * @brief The QuantileSketch class is a mergeable streaming quantile
+ *        estimator after the merging t-digest by Dunning. Values are
+ *        buffered and merged into weighted centroids, the arcsine scale
+ *        function keeps centroids small near the tails, so extreme
+ *        quantiles are accurate. Memory is bounded by the compression:
+ *        at most about compression centroids plus a buffer of
+ *        BUFFER_FACTOR * compression values are kept.
+ */
+template <typename T>
+class QuantileSketch {
+ public:
+  using allocator_t = std::allocator<QuantileSketch<T>>;
+
+  using Ptr = std::shared_ptr<QuantileSketch<T>>;
+
+  struct Centroid {
+    T mean;
+    T weight;
+  };
+  using centroids_t = std::vector<Centroid>;
+
+  static constexpr std::size_t BUFFER_FACTOR = 4;
+
+  /**
+   * @param compression - accuracy versus memory, typically 50 to 500
+   */
+  inline explicit QuantileSketch(const std::size_t compression = 100)
+      : compression_{compression} {
+    centroids_.reserve(compression_);
+    buffer_.reserve(BUFFER_FACTOR * compression_);
+  }
+
+  inline QuantileSketch(const std::size_t compression, const T min,
+                        const T max, const centroids_t &centroids)
+      : QuantileSketch(compression) {
+    for (const Centroid &c : centroids) add(c.mean, c.weight);
+    if (!centroids.empty()) {
+      min_ = min;
+      max_ = max;
+    }
+  }
+
+  inline void reset() {
+    centroids_.clear();
+    buffer_.clear();
+    weight_ = T();
+    min_ = std::numeric_limits<T>::max();
+    max_ = std::numeric_limits<T>::lowest();
+  }
+
+  /// Modification
+  inline void add(const T value, const T weight = T(1)) {
+    if (weight <= T()) return;
+
+    if (buffer_.size() >= BUFFER_FACTOR * compression_) compress();
+    buffer_.push_back(Centroid{value, weight});
+    weight_ += weight;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  template <typename Iterator>
+  inline void add(Iterator first, Iterator last) {
+    for (; first != last; ++first) add(*first);
+  }
+
+  inline QuantileSketch &operator+=(const QuantileSketch &other) {
+    /// copied, other may be this sketch
+    const centroids_t centroids = other.getCentroids();
+    const T min = other.min_;
+    const T max = other.max_;
+    for (const Centroid &c : centroids) add(c.mean, c.weight);
+    if (!centroids.empty()) {
+      min_ = std::min(min_, min);
+      max_ = std::max(max_, max);
+    }
+    return *this;
+  }
+
+  inline void merge(const QuantileSketch &other) { *this += other; }
+
+  /// Sketch properties
+  inline std::size_t getCompression() const { return compression_; }
+
+  inline T getWeight() const { return weight_; }
+
+  inline T getMin() const { return min_; }
+
+  inline T getMax() const { return max_; }
+
+  /**
+   * @brief The centroids sorted by mean, pending values are merged first.
+   */
+  inline centroids_t const &getCentroids() const {
+    compress();
+    return centroids_;
+  }
+
+  /**
+   * @brief Estimate of the q-quantile, q in [0, 1]. The mass of every
+   *        centroid is assumed to be centered at its mean, between the
+   *        centers the estimate is interpolated linearly. Empty sketches
+   *        yield zero.
+   */
+  inline T getQuantile(const T q) const {
+    const centroids_t &c = getCentroids();
+    if (c.empty()) return T();
+    if (q <= T()) return min_;
+    if (q >= T(1)) return max_;
+    if (c.size() == 1) return c.front().mean;
+
+    const T target = q * weight_;
+    T center = c.front().weight / T(2);
+    if (target < center)
+      return min_ + (c.front().mean - min_) * target / center;
+
+    for (std::size_t i = 1; i < c.size(); ++i) {
+      const T next = center + (c[i - 1].weight + c[i].weight) / T(2);
+      if (target < next) {
+        return c[i - 1].mean + (c[i].mean - c[i - 1].mean) *
+                                   (target - center) / (next - center);
+      }
+      center = next;
+    }
+    const T rest = weight_ - center;
+    return c.back().mean + (max_ - c.back().mean) * (target - center) / rest;
+  }
+
+ private:
+  std::size_t compression_;
+  mutable centroids_t centroids_;
+  mutable centroids_t buffer_;
+  T weight_{0};
+  T min_{std::numeric_limits<T>::max()};
+  T max_{std::numeric_limits<T>::lowest()};
+
+  /// arcsine scale function and its inverse
+  inline T scale(const T q) const {
+    return static_cast<T>(compression_) / T(2 * M_PI) *
+           std::asin(T(2) * q - T(1));
+  }
+
+  inline T inverseScale(const T k) const {
+    const T x = T(2 * M_PI) * k / static_cast<T>(compression_);
+    return x >= T(M_PI_2) ? T(1) : (std::sin(x) + T(1)) / T(2);
+  }
+
+  inline void compress() const {
+    if (buffer_.empty()) return;
+
+    buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+    std::sort(buffer_.begin(), buffer_.end(),
+              [](const Centroid &a, const Centroid &b) {
+                return a.mean < b.mean;
+              });
+    centroids_.clear();
+
+    T total = T();
+    for (const Centroid &c : buffer_) total += c.weight;
+
+    Centroid current = buffer_.front();
+    T merged = T();
+    T limit = total * inverseScale(scale(T()) + T(1));
+    for (std::size_t i = 1; i < buffer_.size(); ++i) {
+      const Centroid &next = buffer_[i];
+      if (merged + current.weight + next.weight <= limit) {
+        const T w = current.weight + next.weight;
+        current.mean += (next.mean - current.mean) * next.weight / w;
+        current.weight = w;
+      } else {
+        merged += current.weight;
+        centroids_.push_back(current);
+        limit = total *
+                inverseScale(scale(std::min(merged / total, T(1))) + T(1));
+        current = next;
+      }
+    }
+    centroids_.push_back(current);
+    buffer_.clear();
+  }
+};
+}  // namespace statistics
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_QUANTILE_SKETCH_HPP
@@ -4,10 +4,13 @@
 #include <assert.h>
 
 #include <cslibs_math/approx/sqrt.hpp>
+#include <cslibs_math/linear/cholesky.hpp>
+#include <cslibs_math/linear/symmetric_eigen.hpp>
 #include <cslibs_math/statistics/limit_eigen_values.hpp>
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Eigen>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 
@@ -69,7 +72,7 @@ class EIGEN_ALIGN16 StableDistribution {
 
   inline void add(const StableDistribution &other) {
     const std::size_t _n = n_ + other.n_;
-    const auto dmean = mean_ - other.mean_;
+    const sample_t dmean = mean_ - other.mean_;
     mean_ =
         (mean_ * static_cast<T>(n_) + other.mean_ * static_cast<T>(other.n_)) /
         static_cast<T>(_n);
@@ -91,6 +94,58 @@ class EIGEN_ALIGN16 StableDistribution {
     return *this;
   }
 
+  /**
+   * @brief Remove a sample which has been added before, reverse Welford
+   *        update. Removing the last sample resets the distribution.
+   */
+  inline void remove(const sample_t &p) {
+    if (n_ <= 1) {
+      reset();
+      return;
+    }
+
+    const sample_t _mean = mean_;
+    const std::size_t _n = n_ - 1;
+    mean_ = (mean_ * static_cast<T>(n_) - p) / static_cast<T>(_n);
+    scatter_ -= (p - mean_) * (p - _mean).transpose();
+    n_ = _n;
+
+    information_matrix_ = covariance_t::Zero();
+  }
+
+  /**
+   * @brief Remove a distribution which has been merged before, inverse of
+   *        add(other).
+   */
+  inline void remove(const StableDistribution &other) {
+    if (other.n_ >= n_) {
+      reset();
+      return;
+    }
+
+    const std::size_t _n = n_ - other.n_;
+    mean_ =
+        (mean_ * static_cast<T>(n_) - other.mean_ * static_cast<T>(other.n_)) /
+        static_cast<T>(_n);
+    const sample_t dmean = mean_ - other.mean_;
+    scatter_ -= other.scatter_ + static_cast<T>(_n * other.n_) /
+                                     static_cast<T>(n_) * dmean *
+                                     dmean.transpose();
+    n_ = _n;
+
+    information_matrix_ = covariance_t::Zero();
+  }
+
+  inline StableDistribution &operator-=(const sample_t &p) {
+    remove(p);
+    return *this;
+  }
+
+  inline StableDistribution &operator-=(const StableDistribution &other) {
+    remove(other);
+    return *this;
+  }
+
   inline bool valid() const { return n_ > Dim; }
 
   inline std::size_t getN() const { return n_; }
@@ -152,12 +207,10 @@ class EIGEN_ALIGN16 StableDistribution {
     auto update_return_eigen = [this, &eigen_values, &eigen_vectors, &abs]() {
       if (dirty()) update();
 
-      Eigen::EigenSolver<covariance_t> solver;
-      solver.compute(information_matrix_.inverse().eval());
-      eigen_vectors = solver.eigenvectors().real();
-      eigen_values =
-          abs ? eigen_values_t(solver.eigenvalues().real().cwiseAbs())
-              : solver.eigenvalues().real();
+      const covariance_t covariance = information_matrix_.inverse();
+      linear::SymmetricEigen<T, Dim>::compute(covariance, eigen_values,
+                                              eigen_vectors);
+      if (abs) eigen_values = eigen_values.cwiseAbs();
       return true;
     };
     return valid() ? update_return_eigen() : false;
@@ -173,6 +226,19 @@ class EIGEN_ALIGN16 StableDistribution {
     return valid() ? update_sample() : T();  // T() = zero
   }
 
+  /**
+   * @brief Natural logarithm of sampleNonNormalized(p), -inf for invalid
+   *        distributions.
+   */
+  inline T logSampleNonNormalized(const sample_t &p) const {
+    auto update_sample = [this, &p]() {
+      if (dirty()) update();
+      const sample_t q = p - mean_;
+      return T(-0.5) * q.dot(information_matrix_ * q);
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
   inline T sampleNonNormalized(const sample_t &p, sample_t &q) const {
     auto update_sample = [this, &p, &q]() {
       if (dirty()) update();
@@ -200,9 +266,7 @@ class EIGEN_ALIGN16 StableDistribution {
 
   inline void update() const {
     const T scale = T(1) / static_cast<T>(n_ - 1);
-    information_matrix_ = scale * scatter_;
-
-    information_matrix_ = information_matrix_.inverse().eval();
+    linear::Cholesky<T, Dim>::compute(scale * scatter_, information_matrix_);
   }
 };
 
@@ -215,6 +279,8 @@ class EIGEN_ALIGN16 StableDistribution<T, 1, lambda_ratio_exponent> {
   using Ptr = std::shared_ptr<StableDistribution<T, 1, lambda_ratio_exponent>>;
 
   static constexpr T sqrt_2_M_PI = cslibs_math::approx::sqrt(2.0 * M_PI);
+  static constexpr T log_sqrt_2_M_PI =
+      static_cast<T>(0.918938533204672741780329736406);
 
   inline StableDistribution() = default;
 
@@ -232,6 +298,7 @@ class EIGEN_ALIGN16 StableDistribution<T, 1, lambda_ratio_exponent> {
     n_ = 0;
     variance_ = T();
     standard_deviation_ = T();
+    log_standard_deviation_ = T();
     dirty_ = false;
   }
 
@@ -266,6 +333,47 @@ class EIGEN_ALIGN16 StableDistribution<T, 1, lambda_ratio_exponent> {
     return *this;
   }
 
+  inline void remove(const T s) {
+    if (n_ <= 1) {
+      reset();
+      return;
+    }
+
+    const T _mean = mean_;
+    const std::size_t _n = n_ - 1;
+    mean_ = (mean_ * static_cast<T>(n_) - s) / static_cast<T>(_n);
+    scatter_ -= (s - mean_) * (s - _mean);
+    n_ = _n;
+    dirty_ = true;
+  }
+
+  inline void remove(const StableDistribution &other) {
+    if (other.n_ >= n_) {
+      reset();
+      return;
+    }
+
+    const std::size_t _n = n_ - other.n_;
+    mean_ =
+        (mean_ * static_cast<T>(n_) - other.mean_ * static_cast<T>(other.n_)) /
+        static_cast<T>(_n);
+    const T dmean = mean_ - other.mean_;
+    scatter_ -= other.scatter_ + static_cast<T>(_n * other.n_) /
+                                     static_cast<T>(n_) * dmean * dmean;
+    n_ = _n;
+    dirty_ = true;
+  }
+
+  inline StableDistribution &operator-=(const T s) {
+    remove(s);
+    return *this;
+  }
+
+  inline StableDistribution &operator-=(const StableDistribution &other) {
+    remove(other);
+    return *this;
+  }
+
   inline bool valid() const { return n_ > 1; }
 
   inline std::size_t getN() const { return n_; }
@@ -311,6 +419,26 @@ class EIGEN_ALIGN16 StableDistribution<T, 1, lambda_ratio_exponent> {
     return valid() ? update_sample() : T();
   }
 
+  inline T logSample(const T s) const {
+    auto update_sample = [this, &s]() {
+      if (dirty_) update();
+      const T d = 2.0 * variance_;
+      const T x = s - mean_;
+      return -0.5 * x * x / d - (log_sqrt_2_M_PI + log_standard_deviation_);
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
+  inline T logSampleNonNormalized(const T s) const {
+    auto update_sample = [this, &s]() {
+      if (dirty_) update();
+      const T d = 2.0 * variance_;
+      const T x = s - mean_;
+      return -0.5 * x * x / d;
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
   inline void merge(const StableDistribution &other) { *this += other; }
 
  private:
@@ -320,12 +448,14 @@ class EIGEN_ALIGN16 StableDistribution<T, 1, lambda_ratio_exponent> {
 
   mutable T variance_{0};
   mutable T standard_deviation_{0};
+  mutable T log_standard_deviation_{0};
 
   mutable bool dirty_{false};
 
   inline void update() const {
     variance_ = scatter_ / static_cast<T>(n_ - 1);
     standard_deviation_ = std::sqrt(variance_);
+    log_standard_deviation_ = T(0.5) * std::log(variance_);
     dirty_ = false;
   }
 };
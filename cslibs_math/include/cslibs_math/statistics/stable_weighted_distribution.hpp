@@ -4,10 +4,13 @@
 #include <assert.h>
 
 #include <cslibs_math/approx/sqrt.hpp>
+#include <cslibs_math/linear/cholesky.hpp>
+#include <cslibs_math/linear/symmetric_eigen.hpp>
 #include <cslibs_math/statistics/limit_eigen_values.hpp>
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Eigen>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 
@@ -27,6 +30,8 @@ class EIGEN_ALIGN16 StableWeightedDistribution {
   using covariance_t = Eigen::Matrix<T, Dim, Dim>;
   using eigen_values_t = Eigen::Matrix<T, Dim, 1>;
   using eigen_vectors_t = Eigen::Matrix<T, Dim, Dim>;
+  using samples_t = Eigen::Matrix<T, Dim, Eigen::Dynamic>;
+  using weights_t = Eigen::Matrix<T, Eigen::Dynamic, 1>;
 
   static constexpr T sqrt_2_M_PI = cslibs_math::approx::sqrt(2.0 * M_PI);
 
@@ -75,10 +80,77 @@ class EIGEN_ALIGN16 StableWeightedDistribution {
     information_matrix_ = covariance_t::Zero();
   }
 
+  /**
+   * @brief Add a batch of weighted samples. Mean and scatter of the batch
+   *        are computed in two passes and merged afterwards, therefore the
+   *        iterators have to be forward iterators. Samples with non-positive
+   *        weight are skipped.
+   * @param first         - iterator to the first sample
+   * @param last          - iterator past the last sample
+   * @param weights_first - iterator to the weight of the first sample
+   */
+  template <typename Iterator, typename WeightIterator>
+  inline void add(Iterator first, Iterator last, WeightIterator weights_first) {
+    StableWeightedDistribution batch;
+    sample_t sum = sample_t::Zero();
+    WeightIterator w_it = weights_first;
+    for (Iterator it = first; it != last; ++it, ++w_it) {
+      const T w = *w_it;
+      if (w <= T()) continue;
+
+      sum += w * (*it);
+      batch.W_ += w;
+      batch.W_sq_ += w * w;
+      ++batch.sample_count_;
+    }
+    if (batch.W_ <= T()) return;
+
+    batch.mean_ = sum / batch.W_;
+    w_it = weights_first;
+    for (Iterator it = first; it != last; ++it, ++w_it) {
+      const T w = *w_it;
+      if (w <= T()) continue;
+
+      const sample_t q = *it - batch.mean_;
+      batch.scatter_.noalias() += w * q * q.transpose();
+    }
+    *this += batch;
+  }
+
+  /**
+   * @brief Add a batch of weighted samples given column-wise.
+   * @param samples - Dim x N matrix
+   * @param weights - N weights, non-positive ones are skipped
+   */
+  inline void add(const samples_t &samples, const weights_t &weights) {
+    StableWeightedDistribution batch;
+    sample_t sum = sample_t::Zero();
+    for (Eigen::Index c = 0; c < samples.cols(); ++c) {
+      const T w = weights(c);
+      if (w <= T()) continue;
+
+      sum += w * samples.col(c);
+      batch.W_ += w;
+      batch.W_sq_ += w * w;
+      ++batch.sample_count_;
+    }
+    if (batch.W_ <= T()) return;
+
+    batch.mean_ = sum / batch.W_;
+    for (Eigen::Index c = 0; c < samples.cols(); ++c) {
+      const T w = weights(c);
+      if (w <= T()) continue;
+
+      const sample_t q = samples.col(c) - batch.mean_;
+      batch.scatter_.noalias() += w * q * q.transpose();
+    }
+    *this += batch;
+  }
+
   inline StableWeightedDistribution &operator+=(
       const StableWeightedDistribution &other) {
     const T _W = W_ + other.W_;
-    const auto dmean = mean_ - other.mean_;
+    const sample_t dmean = mean_ - other.mean_;
     mean_ = (mean_ * W_ + other.mean_ * other.W_) / _W;
     scatter_ +=
         other.scatter_ + (W_ * other.W_) / _W * dmean * dmean.transpose();
@@ -149,12 +221,10 @@ class EIGEN_ALIGN16 StableWeightedDistribution {
     auto update_return_eigen = [this, &eigen_values, &eigen_vectors, &abs]() {
       if (dirty()) update();
 
-      Eigen::EigenSolver<covariance_t> solver;
-      solver.compute(information_matrix_.inverse());
-      eigen_vectors = solver.eigenvectors().real();
-      eigen_values =
-          abs ? eigen_values_t(solver.eigenvalues().real().cwiseAbs())
-              : solver.eigenvalues().real();
+      const covariance_t covariance = information_matrix_.inverse();
+      linear::SymmetricEigen<T, Dim>::compute(covariance, eigen_values,
+                                              eigen_vectors);
+      if (abs) eigen_values = eigen_values.cwiseAbs();
       return true;
     };
     return valid() ? update_return_eigen() : false;
@@ -173,6 +243,19 @@ class EIGEN_ALIGN16 StableWeightedDistribution {
     return valid() ? update_sample() : T();
   }
 
+  /**
+   * @brief Natural logarithm of sampleNonNormalized(p), -inf for invalid
+   *        distributions.
+   */
+  inline T logSampleNonNormalized(const sample_t &p) const {
+    auto update_sample = [this, &p]() {
+      if (dirty()) update();
+      const sample_t q = p - mean_;
+      return T(-0.5) * q.dot(information_matrix_ * q);
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
   inline T sampleNonNormalized(const sample_t &p, sample_t &q) const {
     auto update_sample = [this, &p, &q]() {
       if (dirty()) update();
@@ -200,8 +283,7 @@ class EIGEN_ALIGN16 StableWeightedDistribution {
 
   inline void update() const {
     const T scale = T(1.0) / (W_ - W_sq_ / W_);
-    information_matrix_ = scale * scatter_;
-    information_matrix_ = information_matrix_.inverse().eval();
+    linear::Cholesky<T, Dim>::compute(scale * scatter_, information_matrix_);
   }
 };
 
@@ -215,6 +297,8 @@ class EIGEN_ALIGN16 StableWeightedDistribution<T, 1, lambda_ratio_exponent> {
       std::shared_ptr<StableWeightedDistribution<T, 1, lambda_ratio_exponent>>;
 
   static constexpr T sqrt_2_M_PI = cslibs_math::approx::sqrt(2.0 * M_PI);
+  static constexpr T log_sqrt_2_M_PI =
+      static_cast<T>(0.918938533204672741780329736406);
 
   inline StableWeightedDistribution() = default;
 
@@ -242,6 +326,7 @@ class EIGEN_ALIGN16 StableWeightedDistribution<T, 1, lambda_ratio_exponent> {
     W_ = T();
     W_sq_ = T();
     standard_deviation_ = T();
+    log_standard_deviation_ = T();
     dirty_ = false;
   }
 
@@ -316,6 +401,26 @@ class EIGEN_ALIGN16 StableWeightedDistribution<T, 1, lambda_ratio_exponent> {
     return valid() ? update_sample() : T();
   }
 
+  inline T logSample(const T s) const {
+    auto update_sample = [this, &s]() {
+      if (dirty_) update();
+      const T d = 2.0 * variance_;
+      const T x = s - mean_;
+      return -0.5 * x * x / d - (log_sqrt_2_M_PI + log_standard_deviation_);
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
+  inline T logSampleNonNormalized(const T s) const {
+    auto update_sample = [this, &s]() {
+      if (dirty_) update();
+      const T d = 2.0 * variance_;
+      const T x = s - mean_;
+      return -0.5 * x * x / d;
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
   inline void merge(const StableWeightedDistribution &other) { *this += other; }
 
  private:
@@ -327,6 +432,7 @@ class EIGEN_ALIGN16 StableWeightedDistribution<T, 1, lambda_ratio_exponent> {
 
   mutable T variance_{0};
   mutable T standard_deviation_{0};
+  mutable T log_standard_deviation_{0};
 
   mutable bool dirty_{false};
 
@@ -334,6 +440,7 @@ class EIGEN_ALIGN16 StableWeightedDistribution<T, 1, lambda_ratio_exponent> {
     const T scale = T(1) / (W_ - W_sq_ / W_);
     variance_ = scatter_ * scale;  //(squared_ - mean_ * mean_) * scale;
     standard_deviation_ = std::sqrt(variance_);
+    log_standard_deviation_ = T(0.5) * std::log(variance_);
     dirty_ = false;
   }
 };
@@ -1,8 +1,10 @@
 #ifndef CSLIBS_MATH_WEIGHTED_ANGULAR_MEAN_HPP
 #define CSLIBS_MATH_WEIGHTED_ANGULAR_MEAN_HPP
 
+#include <assert.h>
 #include <complex>
 #include <cslibs_math/common/angle.hpp>
+#include <cslibs_math/statistics/angular_mean.hpp>
 #include <eigen3/Eigen/Core>
 #include <memory>
 
@@ -16,6 +18,8 @@ class EIGEN_ALIGN16 WeightedAngularMean {
 
   using Ptr = std::shared_ptr<WeightedAngularMean<T>>;
   using complex_t = Eigen::Matrix<T, 2, 1>;
+  using angles_t = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+  using weights_t = Eigen::Matrix<T, Eigen::Dynamic, 1>;
 
   inline WeightedAngularMean() = default;
   inline WeightedAngularMean(const WeightedAngularMean &other) = default;
@@ -42,7 +46,28 @@ class EIGEN_ALIGN16 WeightedAngularMean {
     dirty_ = true;
   }
 
+  /**
+   * @brief Add a batch of weighted angles. The weighted complex
+   *        representations are summed in blocks and folded into the mean
+   *        with a single division.
+   * @param first         - iterator to the first angle
+   * @param last          - iterator past the last angle
+   * @param weights_first - iterator to the weight of the first angle
+   */
+  template <typename Iterator, typename WeightIterator>
+  inline void add(Iterator first, Iterator last, WeightIterator weights_first) {
+    std::complex<T> sum;
+    fold(detail::sumComplex<T>(first, last, weights_first, sum), sum);
+  }
+
+  inline void add(const angles_t &angles, const weights_t &weights) {
+    assert(angles.size() == weights.size());
+    add(angles.data(), angles.data() + angles.size(), weights.data());
+  }
+
   inline WeightedAngularMean &operator+=(const WeightedAngularMean &other) {
+    if (other.W_ == T()) return *this;
+
     T _W = W_ + other.W_;
     complex_mean_ = (complex_mean_ * W_ + other.complex_mean_ * other.W_) / _W;
     W_ = _W;
@@ -50,6 +75,8 @@ class EIGEN_ALIGN16 WeightedAngularMean {
     return *this;
   }
 
+  inline void merge(const WeightedAngularMean &other) { *this += other; }
+
   inline T getWeight() const { return W_; }
 
   inline T getMean() const {
@@ -77,6 +104,16 @@ class EIGEN_ALIGN16 WeightedAngularMean {
   mutable T mean_{0};
   complex_t complex_mean_{0, 0};
   T W_{0};
+
+  inline void fold(const T w, const std::complex<T> &sum) {
+    if (w == T()) return;
+
+    const T _W = W_ + w;
+    complex_mean_ =
+        (complex_mean_ * W_ + complex_t(sum.real(), sum.imag())) / _W;
+    W_ = _W;
+    dirty_ = true;
+  }
 };
 }  // namespace statistics
 }  // namespace cslibs_math
@@ -4,10 +4,14 @@
 #include <assert.h>
 
 #include <cslibs_math/approx/sqrt.hpp>
+#include <cslibs_math/linear/cholesky.hpp>
+#include <cslibs_math/linear/mahalanobis.hpp>
+#include <cslibs_math/linear/symmetric_eigen.hpp>
 #include <cslibs_math/statistics/limit_eigen_values.hpp>
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Eigen>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 
@@ -27,8 +31,13 @@ class EIGEN_ALIGN16 WeightedDistribution {
   using covariance_t = Eigen::Matrix<T, Dim, Dim>;
   using eigen_values_t = Eigen::Matrix<T, Dim, 1>;
   using eigen_vectors_t = Eigen::Matrix<T, Dim, Dim>;
+  using samples_t = Eigen::Matrix<T, Dim, Eigen::Dynamic>;
+  using weights_t = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+  using densities_t = Eigen::Array<T, Eigen::Dynamic, 1>;
 
   static constexpr T sqrt_2_M_PI = cslibs_math::approx::sqrt(2.0 * M_PI);
+  static constexpr T log_sqrt_2_M_PI =
+      static_cast<T>(0.918938533204672741780329736406);
 
   WeightedDistribution() = default;
 
@@ -60,6 +69,7 @@ class EIGEN_ALIGN16 WeightedDistribution {
     eigen_vectors_ = eigen_vectors_t::Zero();
     eigen_values_ = eigen_values_t::Zero();
     determinant_ = T();
+    log_determinant_ = T();
 
     dirty_ = true;
     dirty_eigenvalues_ = true;
@@ -84,6 +94,56 @@ class EIGEN_ALIGN16 WeightedDistribution {
     dirty_eigenvalues_ = true;
   }
 
+  /**
+   * @brief Add a batch of weighted samples. Weighted raw sums are accumulated
+   *        over the whole batch and folded into mean and correlated matrix
+   *        once. Samples with non-positive weight are skipped.
+   * @param first         - iterator to the first sample
+   * @param last          - iterator past the last sample
+   * @param weights_first - iterator to the weight of the first sample
+   */
+  template <typename Iterator, typename WeightIterator>
+  inline void add(Iterator first, Iterator last, WeightIterator weights_first) {
+    std::size_t sample_count = 0;
+    T w_sum = T();
+    T w_sq_sum = T();
+    sample_t sum = sample_t::Zero();
+    covariance_t correlated = covariance_t::Zero();
+    for (; first != last; ++first, ++weights_first) {
+      const T w = *weights_first;
+      if (w <= T()) continue;
+
+      accumulate(*first, w, sum, correlated);
+      w_sum += w;
+      w_sq_sum += w * w;
+      ++sample_count;
+    }
+    fold(sample_count, w_sum, w_sq_sum, sum, correlated);
+  }
+
+  /**
+   * @brief Add a batch of weighted samples given column-wise.
+   * @param samples - Dim x N matrix
+   * @param weights - N weights, non-positive ones are skipped
+   */
+  inline void add(const samples_t &samples, const weights_t &weights) {
+    std::size_t sample_count = 0;
+    T w_sum = T();
+    T w_sq_sum = T();
+    sample_t sum = sample_t::Zero();
+    covariance_t correlated = covariance_t::Zero();
+    for (Eigen::Index c = 0; c < samples.cols(); ++c) {
+      const T w = weights(c);
+      if (w <= T()) continue;
+
+      accumulate(samples.col(c), w, sum, correlated);
+      w_sum += w;
+      w_sq_sum += w * w;
+      ++sample_count;
+    }
+    fold(sample_count, w_sum, w_sq_sum, sum, correlated);
+  }
+
   inline WeightedDistribution &operator+=(const WeightedDistribution &other) {
     const T _W = W_ + other.W_;
     mean_ = (mean_ * W_ + other.mean_ * other.W_) / _W;
@@ -96,6 +156,16 @@ class EIGEN_ALIGN16 WeightedDistribution {
     return *this;
   }
 
+  /**
+   * @brief Scale the weights of all accumulated samples, e.g. to forget old
+   *        evidence. Mean and covariance are invariant, only the influence
+   *        of samples added later changes.
+   */
+  inline void scale(const T factor) {
+    W_ *= factor;
+    W_sq_ *= factor * factor;
+  }
+
   /// Distribution properties
   inline bool valid() const { return sample_count_ > Dim; }
 
@@ -128,6 +198,18 @@ class EIGEN_ALIGN16 WeightedDistribution {
                                      : covariance_t(covariance_);
   }
 
+  /**
+   * @brief Logarithm of the covariance determinant, see Distribution.
+   */
+  inline T getLogDeterminant() const {
+    auto update_return_log_determinant = [this]() {
+      update();
+      return log_determinant_;
+    };
+    return (dirty_ && valid()) ? update_return_log_determinant()
+                               : log_determinant_;
+  }
+
   inline covariance_t getInformationMatrix() const {
     auto update_return_information = [this]() {
       update();
@@ -252,6 +334,88 @@ class EIGEN_ALIGN16 WeightedDistribution {
     return valid() ? update_sample() : T();
   }
 
+  /**
+   * @brief Natural logarithm of sample(p), computed without the exp/log
+   *        round trip, -inf for invalid distributions.
+   */
+  inline T logSample(const sample_t &p) const {
+    auto update_sample = [this, &p]() {
+      if (dirty_) update();
+      const sample_t q = p - mean_;
+      return T(-0.5) * q.dot(information_matrix_ * q) -
+             (log_determinant_ + log_sqrt_2_M_PI);
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
+  /**
+   * @brief Natural logarithm of sampleNonNormalized(p), -inf for invalid
+   *        distributions.
+   */
+  inline T logSampleNonNormalized(const sample_t &p) const {
+    auto update_sample = [this, &p]() {
+      if (dirty_) update();
+      const sample_t q = p - mean_;
+      return T(-0.5) * q.dot(information_matrix_ * q);
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
+  /**
+   * @brief Batch evaluation, the points are given column-wise and the
+   *        results are written to out, one entry per point. The cached
+   *        values are updated once for the whole batch.
+   *        mahalanobis yields the squared Mahalanobis distances, +inf for
+   *        invalid distributions.
+   */
+  inline void mahalanobis(const samples_t &points, densities_t &out) const {
+    if (!valid()) {
+      out.setConstant(points.cols(), std::numeric_limits<T>::infinity());
+      return;
+    }
+    if (dirty_) update();
+    linear::Mahalanobis<T, Dim>::squared(mean_, information_matrix_, points,
+                                         out);
+  }
+
+  inline void sample(const samples_t &points, densities_t &out) const {
+    if (!valid()) {
+      out.setZero(points.cols());
+      return;
+    }
+    mahalanobis(points, out);
+    out = (T(-0.5) * out).exp() * (T(1.0) / (determinant_ * sqrt_2_M_PI));
+  }
+
+  inline void sampleNonNormalized(const samples_t &points,
+                                  densities_t &out) const {
+    if (!valid()) {
+      out.setZero(points.cols());
+      return;
+    }
+    mahalanobis(points, out);
+    out = (T(-0.5) * out).exp();
+  }
+
+  inline void logSample(const samples_t &points, densities_t &out) const {
+    if (!valid()) {
+      out.setConstant(points.cols(), -std::numeric_limits<T>::infinity());
+      return;
+    }
+    mahalanobis(points, out);
+    out = T(-0.5) * out - (log_determinant_ + log_sqrt_2_M_PI);
+  }
+
+  inline void logSampleNonNormalized(const samples_t &points,
+                                     densities_t &out) const {
+    if (!valid()) {
+      out.setConstant(points.cols(), -std::numeric_limits<T>::infinity());
+      return;
+    }
+    mahalanobis(points, out);
+    out *= T(-0.5);
+  }
+
   inline void merge(const WeightedDistribution &other) { *this += other; }
 
  private:
@@ -266,10 +430,39 @@ class EIGEN_ALIGN16 WeightedDistribution {
   mutable eigen_values_t eigen_values_{eigen_values_t::Zero()};
   mutable eigen_vectors_t eigen_vectors_{eigen_vectors_t::Zero()};
   mutable T determinant_{0};
+  mutable T log_determinant_{0};
 
   mutable bool dirty_{false};
   mutable bool dirty_eigenvalues_{false};
 
+  inline static void accumulate(const sample_t &p, const T w, sample_t &sum,
+                                covariance_t &correlated) {
+    sum += w * p;
+    for (std::size_t i = 0; i < Dim; ++i) {
+      for (std::size_t j = i; j < Dim; ++j) {
+        correlated(i, j) += w * p(i) * p(j);
+      }
+    }
+  }
+
+  inline void fold(const std::size_t sample_count, const T w, const T w_sq,
+                   const sample_t &sum, const covariance_t &correlated) {
+    if (w <= T()) return;
+
+    const T _W = W_ + w;
+    mean_ = (mean_ * W_ + sum) / _W;
+    for (std::size_t i = 0; i < Dim; ++i) {
+      for (std::size_t j = i; j < Dim; ++j) {
+        correlated_(i, j) = (correlated_(i, j) * W_ + correlated(i, j)) / _W;
+      }
+    }
+    sample_count_ += sample_count;
+    W_ = _W;
+    W_sq_ += w_sq;
+    dirty_ = true;
+    dirty_eigenvalues_ = true;
+  }
+
   inline void update() const {
     const T scale = W_ / (W_ - W_sq_ / W_);
     for (std::size_t i = 0; i < Dim; ++i) {
@@ -281,8 +474,10 @@ class EIGEN_ALIGN16 WeightedDistribution {
 
     LimitEigenValues<T, Dim, lambda_ratio_exponent>::apply(covariance_);
 
-    information_matrix_ = covariance_.inverse();
-    determinant_ = covariance_.determinant();
+    covariance_t cholesky;
+    linear::Cholesky<T, Dim>::compute(covariance_, cholesky,
+                                      information_matrix_, determinant_,
+                                      log_determinant_);
 
     dirty_ = false;
   }
@@ -290,10 +485,8 @@ class EIGEN_ALIGN16 WeightedDistribution {
   inline void updateEigenvalues() const {
     if (dirty_) update();
 
-    Eigen::EigenSolver<covariance_t> solver;
-    solver.compute(covariance_);
-    eigen_vectors_ = solver.eigenvectors().real();
-    eigen_values_ = solver.eigenvalues().real();
+    linear::SymmetricEigen<T, Dim>::compute(covariance_, eigen_values_,
+                                            eigen_vectors_);
 
     dirty_eigenvalues_ = false;
   }
@@ -309,6 +502,8 @@ class WeightedDistribution<T, 1, lambda_ratio_exponent> {
       std::shared_ptr<WeightedDistribution<T, 1, lambda_ratio_exponent>>;
 
   static constexpr T sqrt_2_M_PI = cslibs_math::approx::sqrt(2.0 * M_PI);
+  static constexpr T log_sqrt_2_M_PI =
+      static_cast<T>(0.918938533204672741780329736406);
 
   inline WeightedDistribution() = default;
 
@@ -334,6 +529,7 @@ class WeightedDistribution<T, 1, lambda_ratio_exponent> {
     W_ = T();
     W_sq_ = T();
     standard_deviation_ = T();
+    log_standard_deviation_ = T();
     dirty_ = false;
   }
 
@@ -358,6 +554,11 @@ class WeightedDistribution<T, 1, lambda_ratio_exponent> {
     return *this;
   }
 
+  inline void scale(const T factor) {
+    W_ *= factor;
+    W_sq_ *= factor * factor;
+  }
+
   inline bool valid() const { return sample_count_ > 1; }
 
   inline std::size_t getSampleCount() const { return sample_count_; }
@@ -405,6 +606,26 @@ class WeightedDistribution<T, 1, lambda_ratio_exponent> {
     return valid() ? update_sample() : T();
   }
 
+  inline T logSample(const T s) const {
+    auto update_sample = [this, &s]() {
+      if (dirty_) update();
+      const T d = 2.0 * variance_;
+      const T x = s - mean_;
+      return -0.5 * x * x / d - (log_sqrt_2_M_PI + log_standard_deviation_);
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
+  inline T logSampleNonNormalized(const T s) const {
+    auto update_sample = [this, &s]() {
+      if (dirty_) update();
+      const T d = 2.0 * variance_;
+      const T x = s - mean_;
+      return -0.5 * x * x / d;
+    };
+    return valid() ? update_sample() : -std::numeric_limits<T>::infinity();
+  }
+
   inline void merge(const WeightedDistribution &other) { *this += other; }
 
  private:
@@ -416,6 +637,7 @@ class WeightedDistribution<T, 1, lambda_ratio_exponent> {
 
   mutable T variance_{0};
   mutable T standard_deviation_{0};
+  mutable T log_standard_deviation_{0};
 
   mutable bool dirty_{false};
 
@@ -423,6 +645,7 @@ class WeightedDistribution<T, 1, lambda_ratio_exponent> {
     const T scale = W_ / (W_ - W_sq_ / W_);
     variance_ = (squared_ - mean_ * mean_) * scale;
     standard_deviation_ = std::sqrt(variance_);
+    log_standard_deviation_ = T(0.5) * std::log(variance_);
     dirty_ = false;
   }
 
@@ -0,0 +1,92 @@
+#ifndef CSLIBS_MATH_WINDOWED_DISTRIBUTION_HPP
+#define CSLIBS_MATH_WINDOWED_DISTRIBUTION_HPP
+
+#include <array>
+#include <cslibs_math/statistics/stable_distribution.hpp>
+#include <memory>
+#include <type_traits>
+
+namespace cslibs_math {
+namespace statistics {
+/**
+ * @brief The WindowedDistribution class keeps the statistics of the samples
+ *        added during the last Window steps, e.g. scans. Samples of every
+ *        step are collected in a slot of a ring buffer and in a running
+ *        total, on step() the oldest slot is removed from the total by the
+ *        reverse Welford update and cleared. Expiring a step is O(1),
+ *        independent of the number of samples it contains.
+ *        The total is rebuilt from the slots once per revolution of the ring
+ *        to bound the rounding error of repeated removal.
+ */
+template <typename T, std::size_t Dim, std::size_t Window>
+class EIGEN_ALIGN16 WindowedDistribution {
+  static_assert(Window > 0, "Window must not be empty.");
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  using allocator_t =
+      Eigen::aligned_allocator<WindowedDistribution<T, Dim, Window>>;
+
+  using Ptr = std::shared_ptr<WindowedDistribution<T, Dim, Window>>;
+  using distribution_t = StableDistribution<T, Dim>;
+  using sample_t =
+      typename std::conditional<Dim == 1, T, Eigen::Matrix<T, Dim, 1>>::type;
+
+  inline WindowedDistribution() = default;
+
+  inline void reset() {
+    for (auto &slot : slots_) slot.reset();
+    total_.reset();
+    current_ = 0;
+  }
+
+  /// Modification
+  inline void add(const sample_t &p) {
+    slots_[current_].add(p);
+    total_.add(p);
+  }
+
+  inline WindowedDistribution &operator+=(const sample_t &p) {
+    add(p);
+    return *this;
+  }
+
+  /**
+   * @brief Begin the next step, the samples of the oldest step expire.
+   */
+  inline void step() {
+    current_ = (current_ + 1) % Window;
+    distribution_t &oldest = slots_[current_];
+    if (oldest.getN() > 0) total_.remove(oldest);
+    oldest.reset();
+
+    if (current_ == 0) rebuild();
+  }
+
+  /// Distribution access
+  inline const distribution_t &getDistribution() const { return total_; }
+
+  inline const distribution_t &getStep(const std::size_t age) const {
+    return slots_[(current_ + Window - age % Window) % Window];
+  }
+
+  inline std::size_t getN() const { return total_.getN(); }
+
+  inline bool valid() const { return total_.valid(); }
+
+ private:
+  std::array<distribution_t, Window> slots_;
+  distribution_t total_;
+  std::size_t current_ = 0;
+
+  inline void rebuild() {
+    total_.reset();
+    for (const auto &slot : slots_) {
+      if (slot.getN() > 0) total_.add(slot);
+    }
+  }
+};
+}  // namespace statistics
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_WINDOWED_DISTRIBUTION_HPP
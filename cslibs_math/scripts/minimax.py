@@ -0,0 +1,278 @@
+#!/usr/bin/python3
+"""
+Minimax coefficients of the polynomial approx:: kernels.
+
+Every polynomial is fitted in the relative error with the Remez exchange
+algorithm in 60 digit decimal arithmetic. The coefficients are rounded to
+float and double, and the error bound reached with the rounded coefficients
+is measured again. Both are written as constexpr tables to
+include/cslibs_math/approx/minimax_coefficients.hpp, which
+test_minimax_coefficients checks against the claimed bounds.
+
+Regenerate with the cslibs_math_minimax_coefficients target or with
+    ./minimax.py [output file]
+Only the standard library is needed.
+"""
+
+import math
+import os
+import struct
+import sys
+from decimal import Decimal, ROUND_CEILING, getcontext
+
+getcontext().prec = 60
+
+D = Decimal
+SERIES_EPSILON = D(10) ** -58
+
+TIERS = ['Coarse', 'Fine', 'Full']
+
+
+def exp(x):
+    return x.exp()
+
+
+def atanh_ratio(z):
+    """atanh(sqrt(z)) / sqrt(z) = sum z^k / (2k + 1)"""
+    result, term, k = D(0), D(1), 0
+    while abs(term) > SERIES_EPSILON:
+        result += term / (2 * k + 1)
+        term *= z
+        k += 1
+    return result
+
+
+def atan_ratio(z):
+    """atan(sqrt(z)) / sqrt(z) = sum (-z)^k / (2k + 1)"""
+    result, term, k = D(0), D(1), 0
+    while abs(term) > SERIES_EPSILON:
+        result += term / (2 * k + 1)
+        term *= -z
+        k += 1
+    return result
+
+
+def evaluate(c, x):
+    p = D(0)
+    for coefficient in reversed(c):
+        p = p * x + coefficient
+    return p
+
+
+def powers(x, degree):
+    result = [D(1)]
+    for _ in range(degree):
+        result.append(result[-1] * x)
+    return result
+
+
+def relative_error(f, c, x):
+    fx = f(x)
+    return (evaluate(c, x) - fx) / fx
+
+
+def solve(matrix, rhs):
+    """Gaussian elimination with partial pivoting."""
+    n = len(rhs)
+    a = [row[:] + [r] for row, r in zip(matrix, rhs)]
+    for i in range(n):
+        pivot = max(range(i, n), key=lambda r: abs(a[r][i]))
+        a[i], a[pivot] = a[pivot], a[i]
+        for r in range(i + 1, n):
+            factor = a[r][i] / a[i][i]
+            for k in range(i, n + 1):
+                a[r][k] -= factor * a[i][k]
+    x = [D(0)] * n
+    for i in reversed(range(n)):
+        x[i] = (a[i][n] - sum(a[i][k] * x[k] for k in range(i + 1, n))) / \
+            a[i][i]
+    return x
+
+
+def maximize(g, lo, hi, iterations=60):
+    """Golden section search for the maximum of the unimodal g."""
+    ratio = (D(5).sqrt() - 1) / 2
+    x1 = hi - ratio * (hi - lo)
+    x2 = lo + ratio * (hi - lo)
+    g1, g2 = g(x1), g(x2)
+    for _ in range(iterations):
+        if g1 < g2:
+            lo, x1, g1 = x1, x2, g2
+            x2 = lo + ratio * (hi - lo)
+            g2 = g(x2)
+        else:
+            hi, x2, g2 = x2, x1, g1
+            x1 = hi - ratio * (hi - lo)
+            g1 = g(x1)
+    candidates = [(g(lo), lo), (g1, x1), (g2, x2), (g(hi), hi)]
+    return max(candidates)[1]
+
+
+def extrema(f, c, a, b, samples=2000):
+    """Local extrema of the relative error with alternating signs."""
+    xs = [a + (b - a) * i / samples for i in range(samples + 1)]
+    es = [relative_error(f, c, x) for x in xs]
+    runs = []
+    for i, e in enumerate(es):
+        if runs and (e >= 0) == (es[runs[-1][-1]] >= 0):
+            runs[-1].append(i)
+        else:
+            runs.append([i])
+    result = []
+    for run in runs:
+        i = max(run, key=lambda k: abs(es[k]))
+        sign = 1 if es[i] >= 0 else -1
+        x = maximize(lambda t: sign * relative_error(f, c, t),
+                     xs[max(i - 1, 0)], xs[min(i + 1, samples)])
+        result.append((x, relative_error(f, c, x)))
+    return result
+
+
+def remez(f, a, b, degree, iterations=40):
+    n = degree + 2
+    xs = [(a + b) / 2 - (b - a) / 2 * D(math.cos(math.pi * i / (n - 1)))
+          for i in range(n)]
+    c = None
+    for _ in range(iterations):
+        matrix = [powers(x, degree) + [(-1) ** i * f(x)]
+                  for i, x in enumerate(xs)]
+        solution = solve(matrix, [f(x) for x in xs])
+        c, level = solution[:-1], abs(solution[-1])
+        points = extrema(f, c, a, b)
+        while len(points) > n:
+            points.pop(0 if abs(points[0][1]) < abs(points[-1][1]) else -1)
+        if len(points) < n:
+            raise RuntimeError('no alternation of degree %d' % degree)
+        xs = [x for x, _ in points]
+        if max(abs(e) for _, e in points) <= level * (1 + D('1e-6')):
+            break
+    return c
+
+
+def to_float(value):
+    return D(struct.unpack('f', struct.pack('f', float(value)))[0])
+
+
+def to_double(value):
+    return D(float(value))
+
+
+def bound(f, c, a, b):
+    """Maximum relative error, rounded up to two significant digits."""
+    error = max(abs(e) for _, e in extrema(f, c, a, b))
+    exponent = error.adjusted() - 1
+    return (error.scaleb(-exponent).to_integral_value(ROUND_CEILING)
+            .scaleb(exponent))
+
+
+def literal(value, scalar):
+    if scalar == 'float':
+        text = '%.9g' % float(value)
+    else:
+        text = repr(float(value))
+    if '.' not in text and 'e' not in text:
+        text += '.0'
+    return text + ('f' if scalar == 'float' else '')
+
+
+def error_literal(value, scalar):
+    text = '%.1e' % float(value)
+    return text + ('f' if scalar == 'float' else '')
+
+
+LN2_2 = D(2).ln() / 2
+SQRT2 = D(2).sqrt()
+LOG_Z = (3 - 2 * SQRT2) ** 2
+ATAN_Z = 3 - 2 * SQRT2
+
+# name, documentation, function, interval and degrees per scalar and tier
+POLYNOMIALS = [
+    ('ExpPolynomial',
+     ['Minimax polynomials p(r) ~ exp(r) for |r| <= ln(2) / 2.'],
+     exp, -LN2_2, LN2_2,
+     {'float': [3, 5, 6], 'double': [3, 5, 11]}),
+    ('LogPolynomial',
+     ['Minimax polynomials p(z) ~ atanh(s) / s with z = s^2 for',
+      '|s| <= 3 - 2 sqrt(2), so ln(m) = 2 s p(s^2) for m in',
+      '[sqrt(1/2), sqrt(2)] and s = (m - 1) / (m + 1).'],
+     atanh_ratio, D(0), LOG_Z,
+     {'float': [1, 2, 3], 'double': [1, 2, 7]}),
+    ('AtanPolynomial',
+     ['Minimax polynomials p(z) ~ atan(u) / u with z = u^2 for',
+      '|u| <= tan(pi / 8), so atan(u) = u p(u^2).'],
+     atan_ratio, D(0), ATAN_Z,
+     {'float': [2, 4, 4], 'double': [2, 4, 10]}),
+]
+
+DOCUMENTATION = [
+    'The coefficients are in increasing order, error is the maximum',
+    'relative error of p with the rounded coefficients.']
+
+HEADER = '''\
+// Generated by scripts/minimax.py, do not edit. Regenerate with the
+// cslibs_math_minimax_coefficients target.
+#ifndef CSLIBS_MATH_MINIMAX_COEFFICIENTS_HPP
+#define CSLIBS_MATH_MINIMAX_COEFFICIENTS_HPP
+
+#include <cslibs_math/approx/accuracy.hpp>
+#include <cstddef>
+
+namespace cslibs_math {
+namespace approx {
+namespace detail {
+'''
+
+FOOTER = '''\
+}  // namespace detail
+}  // namespace approx
+}  // namespace cslibs_math
+
+#endif  // CSLIBS_MATH_MINIMAX_COEFFICIENTS_HPP
+'''
+
+
+def generate():
+    out = [HEADER]
+    for name, documentation, f, a, b, degrees in POLYNOMIALS:
+        if len(out) > 1:
+            out.append('\n')
+        lines = documentation + DOCUMENTATION
+        out.append('/**\n * @brief %s\n' % lines[0])
+        out.extend(' *        %s\n' % line for line in lines[1:])
+        out.append(' */\n'
+                   'template <typename T, ExpAccuracy Accuracy>\n'
+                   'struct %s;\n' % name)
+        for scalar, rounding in (('float', to_float), ('double', to_double)):
+            for tier, degree in zip(TIERS, degrees[scalar]):
+                c = [rounding(v) for v in remez(f, a, b, degree)]
+                error = bound(f, c, a, b)
+                sys.stderr.write('%s<%s, %s>: degree %d, error %s\n' %
+                                 (name, scalar, tier, degree,
+                                  error_literal(error, 'double')))
+                out.append('\ntemplate <>\n'
+                           'struct %s<%s, ExpAccuracy::%s> {\n'
+                           '  static constexpr %s error = %s;\n'
+                           '  static constexpr std::size_t degree = %d;\n'
+                           '  static constexpr %s coefficients[degree + 1] = '
+                           '{\n' % (name, scalar, tier, scalar,
+                                    error_literal(error, scalar), degree,
+                                    scalar))
+                out.append(',\n'.join('      ' + literal(v, scalar)
+                                      for v in c))
+                out.append('};\n};\n')
+    out.append(FOOTER)
+    return ''.join(out)
+
+
+def main():
+    default = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..',
+                           'include', 'cslibs_math', 'approx',
+                           'minimax_coefficients.hpp')
+    path = sys.argv[1] if len(sys.argv) > 1 else default
+    text = generate()
+    with open(path, 'w') as file:
+        file.write(text)
+
+
+if __name__ == '__main__':
+    main()
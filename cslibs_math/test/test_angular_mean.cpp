@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/angular_mean.hpp>
+#include <cslibs_math/statistics/parallel_accumulate.hpp>
+#include <cslibs_math/statistics/weighted_angular_mean.hpp>
+#include <list>
+
+/// not a multiple of the block size to cover the remainder
+const std::size_t NUM_SAMPLES = 1000;
+
+template <typename T>
+void testAngularMean(const T eps) {
+  using mean_t = cslibs_math::statistics::AngularMean<T>;
+  cslibs_math::random::Uniform<T, 1> rng(-M_PI, M_PI);
+  std::vector<T> angles(NUM_SAMPLES);
+  for (auto &a : angles) a = 0.5 * rng.get() + 1.0;
+
+  mean_t single;
+  for (const T a : angles) single.add(a);
+
+  mean_t batch;
+  batch.add(angles.begin(), angles.end());
+  EXPECT_EQ(single.getN(), batch.getN());
+  EXPECT_NEAR(single.getMean(), batch.getMean(), eps);
+  EXPECT_NEAR(single.getVariance(), batch.getVariance(), eps);
+
+  /// non random access range, split in two batches
+  const std::list<T> list(angles.begin(), angles.end());
+  mean_t split;
+  split.add(list.begin(), std::next(list.begin(), NUM_SAMPLES / 3));
+  split.add(std::next(list.begin(), NUM_SAMPLES / 3), list.end());
+  split.add(list.end(), list.end());
+  EXPECT_EQ(single.getN(), split.getN());
+  EXPECT_NEAR(single.getMean(), split.getMean(), eps);
+
+  /// merging with empty means leaves the mean unchanged
+  mean_t merged;
+  merged.merge(mean_t());
+  merged.merge(batch);
+  merged += mean_t();
+  EXPECT_EQ(single.getN(), merged.getN());
+  EXPECT_NEAR(single.getMean(), merged.getMean(), eps);
+
+  const auto add = [](mean_t &m, const std::vector<T> &range) {
+    m.add(range.begin(), range.end());
+  };
+  std::vector<std::vector<T>> chunks(4);
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i)
+    chunks[i % chunks.size()].push_back(angles[i]);
+  const mean_t parallel =
+      cslibs_math::statistics::parallelAccumulate<mean_t>(chunks, 4, add);
+  EXPECT_NEAR(single.getMean(), parallel.getMean(), eps);
+}
+
+template <typename T>
+void testWeightedAngularMean(const T eps) {
+  using mean_t = cslibs_math::statistics::WeightedAngularMean<T>;
+  cslibs_math::random::Uniform<T, 1> rng(-M_PI, M_PI);
+  cslibs_math::random::Uniform<T, 1> rng_weight(0.0, 1.0);
+  typename mean_t::angles_t angles(NUM_SAMPLES);
+  typename mean_t::weights_t weights(NUM_SAMPLES);
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) {
+    angles(i) = 0.5 * rng.get() - 2.0;
+    weights(i) = i % 7 == 0 ? T() : rng_weight.get();
+  }
+
+  mean_t single;
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i)
+    single.add(angles(i), weights(i));
+
+  mean_t batch;
+  batch.add(angles, weights);
+  EXPECT_NEAR(single.getWeight(), batch.getWeight(), eps);
+  EXPECT_NEAR(single.getMean(), batch.getMean(), eps);
+  EXPECT_NEAR(single.getCovariance(), batch.getCovariance(), eps);
+
+  mean_t range;
+  range.add(angles.data(), angles.data() + NUM_SAMPLES / 2, weights.data());
+  range.add(angles.data() + NUM_SAMPLES / 2, angles.data() + NUM_SAMPLES,
+            weights.data() + NUM_SAMPLES / 2);
+  EXPECT_NEAR(single.getWeight(), range.getWeight(), eps);
+  EXPECT_NEAR(single.getMean(), range.getMean(), eps);
+
+  mean_t merged;
+  merged.merge(mean_t());
+  merged.merge(range);
+  merged += mean_t();
+  EXPECT_NEAR(single.getMean(), merged.getMean(), eps);
+}
+
+TEST(Test_cslibs_math, testAngularMeanBatch) {
+  testAngularMean<double>(1e-9);
+  testAngularMean<float>(1e-4f);
+}
+
+TEST(Test_cslibs_math, testWeightedAngularMeanBatch) {
+  testWeightedAngularMean<double>(1e-9);
+  testWeightedAngularMean<float>(1e-3f);
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
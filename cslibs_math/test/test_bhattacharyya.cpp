@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/linear/symmetric_inverse.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/bhattacharyya.hpp>
+
+const std::size_t NUM_DISTRIBUTIONS = 50;
+const std::size_t NUM_SAMPLES = 20;
+
+template <std::size_t Dim>
+double reference(const Eigen::Matrix<double, Dim, Dim> &s_a,
+                 const Eigen::Matrix<double, Dim, 1> &m_a,
+                 const Eigen::Matrix<double, Dim, Dim> &s_b,
+                 const Eigen::Matrix<double, Dim, 1> &m_b) {
+  const Eigen::Matrix<double, Dim, 1> dm = m_a - m_b;
+  const Eigen::Matrix<double, Dim, Dim> s = (s_a + s_b) * 0.5;
+  return 0.125 * dm.dot(s.inverse() * dm) +
+         0.5 * std::log(s.determinant() /
+                        std::sqrt(s_a.determinant() * s_b.determinant()));
+}
+
+template <std::size_t Dim>
+void testSymmetricInverse() {
+  using matrix_t = Eigen::Matrix<double, Dim, Dim>;
+  cslibs_math::random::Uniform<double, 1> rng(-10.0, 10.0, 42);
+  for (std::size_t r = 0; r < 100; ++r) {
+    matrix_t a;
+    for (std::size_t i = 0; i < Dim; ++i)
+      for (std::size_t j = 0; j < Dim; ++j) a(i, j) = rng.get();
+    const matrix_t m = a * a.transpose();
+
+    matrix_t inverse;
+    const double det =
+        cslibs_math::linear::SymmetricInverse<double, Dim>::compute(m, inverse);
+    EXPECT_NEAR(m.determinant(), det, 1e-9 * std::abs(m.determinant()));
+    EXPECT_NEAR(
+        0.0, (m * inverse - matrix_t::Identity()).cwiseAbs().maxCoeff(), 1e-6);
+  }
+
+  using inverse_t = cslibs_math::linear::SymmetricInverse<double, Dim>;
+  matrix_t inverse;
+  EXPECT_EQ(0.0, inverse_t::compute(matrix_t::Zero(), inverse));
+  EXPECT_TRUE(inverse.isZero());
+}
+
+template <std::size_t Dim>
+void testMatrix() {
+  using distribution_t = cslibs_math::statistics::Distribution<double, Dim>;
+  using sample_t = typename distribution_t::sample_t;
+  using matrix_t = cslibs_math::statistics::BhattacharyyaMatrix<double, Dim>;
+
+  cslibs_math::random::Uniform<double, Dim> rng_mean(
+      sample_t::Constant(-10.0), sample_t::Constant(10.0), 42);
+  cslibs_math::random::Uniform<double, Dim> rng(sample_t::Constant(-1.0),
+                                                sample_t::Constant(1.0), 43);
+  std::vector<distribution_t, typename distribution_t::allocator_t>
+      distributions(NUM_DISTRIBUTIONS);
+  for (auto &d : distributions) {
+    const sample_t mean = rng_mean.get();
+    for (std::size_t i = 0; i < NUM_SAMPLES; ++i) d.add(mean + rng.get());
+  }
+  /// one invalid distribution
+  distributions[NUM_DISTRIBUTIONS / 2].reset();
+
+  const matrix_t bhattacharyya(distributions);
+  ASSERT_EQ(NUM_DISTRIBUTIONS, bhattacharyya.size());
+
+  const typename matrix_t::matrix_t dense = bhattacharyya.dense(4);
+  EXPECT_TRUE(dense == bhattacharyya.dense(1));
+  for (std::size_t i = 0; i < NUM_DISTRIBUTIONS; ++i) {
+    EXPECT_EQ(0.0, dense(i, i));
+    for (std::size_t j = i + 1; j < NUM_DISTRIBUTIONS; ++j) {
+      EXPECT_EQ(dense(i, j), dense(j, i));
+      const distribution_t &a = distributions[i];
+      const distribution_t &b = distributions[j];
+      if (!a.valid() || !b.valid()) {
+        EXPECT_EQ(std::numeric_limits<double>::infinity(), dense(i, j));
+        continue;
+      }
+      const double expected = reference<Dim>(
+          a.getCovariance(), a.getMean(), b.getCovariance(), b.getMean());
+      EXPECT_NEAR(expected, dense(i, j), 1e-9 * std::max(1.0, expected));
+      EXPECT_NEAR(expected, cslibs_math::statistics::bhattacharyya(a, b),
+                  1e-9 * std::max(1.0, expected));
+    }
+  }
+
+  const std::size_t k = 5;
+  const typename matrix_t::neighbors_t nearest = bhattacharyya.nearest(k, 3);
+  ASSERT_EQ(NUM_DISTRIBUTIONS, nearest.size());
+  for (std::size_t i = 0; i < NUM_DISTRIBUTIONS; ++i) {
+    if (!distributions[i].valid()) {
+      EXPECT_TRUE(nearest[i].empty());
+      continue;
+    }
+    ASSERT_EQ(k, nearest[i].size());
+    std::vector<double> row;
+    for (std::size_t j = 0; j < NUM_DISTRIBUTIONS; ++j)
+      if (j != i && distributions[j].valid()) row.push_back(dense(i, j));
+    std::sort(row.begin(), row.end());
+    for (std::size_t n = 0; n < k; ++n) {
+      EXPECT_NE(i, nearest[i][n].index);
+      EXPECT_EQ(row[n], nearest[i][n].distance);
+      EXPECT_EQ(dense(i, nearest[i][n].index), nearest[i][n].distance);
+    }
+  }
+}
+
+/// the distance is invariant to scaling the samples, also when the
+/// determinants of the scaled covariances underflow
+template <std::size_t Dim>
+void testSmallCovariances(const double scale) {
+  using distribution_t = cslibs_math::statistics::Distribution<double, Dim>;
+  using sample_t = typename distribution_t::sample_t;
+
+  cslibs_math::random::Uniform<double, Dim> rng(sample_t::Constant(-1.0),
+                                                sample_t::Constant(1.0), 42);
+  distribution_t a, b, a_scaled, b_scaled;
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) {
+    const sample_t p = rng.get();
+    const sample_t q = 0.5 * rng.get() + sample_t::Constant(0.25);
+    a.add(p);
+    b.add(q);
+    a_scaled.add(scale * p);
+    b_scaled.add(scale * q);
+  }
+  ASSERT_EQ(0.0, a_scaled.getCovariance().determinant());
+
+  const double expected = cslibs_math::statistics::bhattacharyya(a, b);
+  EXPECT_NEAR(expected,
+              cslibs_math::statistics::bhattacharyya(a_scaled, b_scaled),
+              1e-9 * expected);
+  const double matrices = cslibs_math::statistics::bhattacharyya<double, Dim>(
+      a_scaled.getCovariance(), a_scaled.getMean(), b_scaled.getCovariance(),
+      b_scaled.getMean());
+  EXPECT_NEAR(expected, matrices, 1e-9 * expected);
+}
+
+TEST(Test_cslibs_math, testSymmetricInverse) {
+  testSymmetricInverse<2>();
+  testSymmetricInverse<3>();
+  testSymmetricInverse<4>();
+}
+
+TEST(Test_cslibs_math, testBhattacharyyaMatrix2D) { testMatrix<2>(); }
+
+TEST(Test_cslibs_math, testBhattacharyyaMatrix3D) { testMatrix<3>(); }
+
+TEST(Test_cslibs_math, testBhattacharyyaSmallCovariances) {
+  testSmallCovariances<2>(1e-80);
+  testSmallCovariances<3>(1e-55);
+  testSmallCovariances<4>(1e-45);
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/linear/cholesky.hpp>
+#include <cslibs_math/random/random.hpp>
+
+const std::size_t REPETITIONS = 1000;
+
+template <typename T, std::size_t Dim>
+void testPositiveDefinite(const T eps) {
+  using matrix_t = Eigen::Matrix<T, Dim, Dim>;
+  using cholesky_t = cslibs_math::linear::Cholesky<T, Dim>;
+  cslibs_math::random::Uniform<T, 1> rng(-10.0, 10.0);
+
+  for (std::size_t r = 0; r < REPETITIONS; ++r) {
+    matrix_t a;
+    for (std::size_t i = 0; i < Dim; ++i)
+      for (std::size_t j = 0; j < Dim; ++j) a(i, j) = rng.get();
+    const matrix_t m = a * a.transpose() + matrix_t::Identity();
+
+    matrix_t lower, inverse, inverse_only;
+    T determinant, log_determinant;
+    ASSERT_TRUE(cholesky_t::compute(m, lower, inverse, determinant,
+                                    log_determinant));
+    ASSERT_TRUE(cholesky_t::compute(m, inverse_only));
+
+    const Eigen::LLT<matrix_t> llt(m);
+    const matrix_t expected_lower = llt.matrixL();
+    EXPECT_TRUE(expected_lower.isApprox(lower, eps));
+    EXPECT_TRUE((lower * lower.transpose()).isApprox(m, eps));
+    EXPECT_TRUE((m * inverse).isApprox(matrix_t::Identity(), eps));
+    EXPECT_TRUE(inverse.isApprox(inverse_only, eps));
+    EXPECT_NEAR(1.0, determinant / m.determinant(), eps);
+    EXPECT_NEAR(std::log(m.determinant()), log_determinant, eps);
+  }
+}
+
+template <typename T, std::size_t Dim>
+void testIndefinite() {
+  using matrix_t = Eigen::Matrix<T, Dim, Dim>;
+  using cholesky_t = cslibs_math::linear::Cholesky<T, Dim>;
+  matrix_t m = matrix_t::Identity();
+  m(Dim - 1, Dim - 1) = -2.0;
+
+  matrix_t lower, inverse;
+  T determinant, log_determinant;
+  EXPECT_FALSE(cholesky_t::compute(m, lower, inverse, determinant,
+                                   log_determinant));
+  EXPECT_TRUE(lower.isZero());
+  EXPECT_TRUE((m * inverse).isApprox(matrix_t::Identity()));
+  EXPECT_NEAR(-2.0, determinant, 1e-6);
+  EXPECT_FALSE(cholesky_t::compute(m, inverse));
+}
+
+/// inverse and log-determinant of scale * m are derived from the factor and
+/// stay exact, although the determinant underflows
+template <std::size_t Dim>
+void testSmall(const double scale) {
+  using matrix_t = Eigen::Matrix<double, Dim, Dim>;
+  using cholesky_t = cslibs_math::linear::Cholesky<double, Dim>;
+  cslibs_math::random::Uniform<double, 1> rng(-10.0, 10.0, 42);
+
+  matrix_t a;
+  for (std::size_t i = 0; i < Dim; ++i)
+    for (std::size_t j = 0; j < Dim; ++j) a(i, j) = rng.get();
+  const matrix_t m = a * a.transpose() + matrix_t::Identity();
+  const matrix_t small = scale * m;
+  ASSERT_EQ(0.0, small.determinant());
+
+  matrix_t lower, inverse;
+  double determinant, log_determinant;
+  ASSERT_TRUE(cholesky_t::compute(small, lower, inverse, determinant,
+                                  log_determinant));
+  const double expected =
+      std::log(m.determinant()) + static_cast<double>(Dim) * std::log(scale);
+  EXPECT_NEAR(expected, log_determinant, 1e-9 * std::abs(expected));
+  EXPECT_TRUE((small * inverse).isApprox(matrix_t::Identity(), 1e-9));
+}
+
+TEST(Test_cslibs_math, testCholeskyPositiveDefinite) {
+  testPositiveDefinite<double, 2>(1e-9);
+  testPositiveDefinite<double, 3>(1e-9);
+  testPositiveDefinite<double, 4>(1e-9);
+  testPositiveDefinite<float, 2>(1e-2f);
+  testPositiveDefinite<float, 3>(1e-2f);
+}
+
+TEST(Test_cslibs_math, testCholeskySmall) {
+  testSmall<2>(1e-160);
+  testSmall<3>(1e-110);
+  testSmall<4>(1e-80);
+}
+
+TEST(Test_cslibs_math, testCholeskyIndefinite) {
+  testIndefinite<double, 2>();
+  testIndefinite<double, 3>();
+  testIndefinite<float, 3>();
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/compact_distribution.hpp>
+
+const std::size_t NUM_SAMPLES = 500;
+const std::size_t NUM_QUERIES = 100;
+
+template <std::size_t Dim>
+void testCompact() {
+  using compact_t = cslibs_math::statistics::CompactDistribution<double, Dim>;
+  using distribution_t = typename compact_t::distribution_t;
+  using stable_t = typename compact_t::stable_distribution_t;
+  using sample_t = typename compact_t::sample_t;
+  cslibs_math::random::Uniform<double, Dim> rng(sample_t::Constant(-10.0),
+                                                sample_t::Constant(10.0));
+
+  compact_t c;
+  compact_t half;
+  distribution_t d;
+  stable_t s;
+  typename compact_t::Scratch scratch;
+  EXPECT_FALSE(c.derive(scratch));
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) {
+    const sample_t p = rng.get();
+    c.add(p);
+    d.add(p);
+    s.add(p);
+    if (i % 2 == 0) half += p;
+  }
+
+  EXPECT_EQ(d.getN(), c.getN());
+  EXPECT_TRUE(d.getMean().isApprox(c.getMean(), 1e-12));
+  EXPECT_TRUE(s.getScatter().isApprox(c.getScatter(), 1e-12));
+
+  ASSERT_TRUE(c.derive(scratch, true));
+  EXPECT_TRUE(d.getCovariance().isApprox(scratch.covariance, 1e-9));
+  EXPECT_TRUE(
+      d.getInformationMatrix().isApprox(scratch.information_matrix, 1e-9));
+  EXPECT_TRUE(d.getEigenValues().isApprox(scratch.eigen_values, 1e-9));
+  for (std::size_t i = 0; i < NUM_QUERIES; ++i) {
+    const sample_t p = rng.get();
+    EXPECT_NEAR(d.sample(p), c.sample(p, scratch), 1e-12);
+    EXPECT_NEAR(d.sampleNonNormalized(p), c.sampleNonNormalized(p, scratch),
+                1e-9);
+    EXPECT_NEAR(d.logSample(p), c.logSample(p, scratch), 1e-9);
+  }
+
+  /// conversions
+  const compact_t from_distribution(d);
+  EXPECT_EQ(c.getN(), from_distribution.getN());
+  EXPECT_TRUE(c.getScatter().isApprox(from_distribution.getScatter(), 1e-9));
+  const compact_t from_stable(s);
+  EXPECT_TRUE(c.getScatter().isApprox(from_stable.getScatter(), 1e-12));
+  const distribution_t to_distribution = c.toDistribution();
+  EXPECT_EQ(d.getN(), to_distribution.getN());
+  EXPECT_TRUE(
+      d.getCovariance().isApprox(to_distribution.getCovariance(), 1e-9));
+  const stable_t to_stable = c.toStableDistribution();
+  EXPECT_TRUE(s.getCovariance().isApprox(to_stable.getCovariance(), 1e-12));
+  EXPECT_EQ(0ul, compact_t().toDistribution().getN());
+
+  /// merging
+  compact_t merged;
+  merged += compact_t();
+  EXPECT_EQ(0ul, merged.getN());
+  merged += half;
+  EXPECT_TRUE(half.getScatter().isApprox(merged.getScatter(), 1e-12));
+  merged += c;
+  stable_t reference = half.toStableDistribution();
+  reference += s;
+  EXPECT_EQ(reference.getN(), merged.getN());
+  EXPECT_TRUE(reference.getScatter().isApprox(merged.getScatter(), 1e-12));
+
+  c.reset();
+  EXPECT_EQ(0ul, c.getN());
+  EXPECT_FALSE(c.valid());
+}
+
+TEST(Test_cslibs_math, testCompactDistribution) {
+  testCompact<2>();
+  testCompact<3>();
+  testCompact<4>();
+}
+
+TEST(Test_cslibs_math, testCompactDistributionSize) {
+  using compact_t = cslibs_math::statistics::CompactDistribution<double, 3>;
+  EXPECT_EQ(sizeof(std::size_t) + (3 + 6) * sizeof(double), sizeof(compact_t));
+  EXPECT_GE(sizeof(compact_t::distribution_t), 4 * sizeof(compact_t));
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/decaying_distribution.hpp>
+
+const std::size_t NUM_EPOCHS = 40;
+const std::size_t SAMPLES_PER_EPOCH = 10;
+const double FACTOR = 0.9;
+
+template <std::size_t Dim>
+void testDecay() {
+  using decaying_t =
+      cslibs_math::statistics::DecayingDistribution<double, Dim>;
+  using weighted_t = typename decaying_t::distribution_t;
+  using sample_t = Eigen::Matrix<double, Dim, 1>;
+  cslibs_math::random::Uniform<double, Dim> rng(sample_t::Constant(-10.0),
+                                                sample_t::Constant(10.0));
+
+  typename decaying_t::decay_clock_t clock(FACTOR);
+  decaying_t lazy;
+  decaying_t eager;
+  std::vector<sample_t, Eigen::aligned_allocator<sample_t>> samples;
+  std::vector<std::size_t> epochs;
+  for (std::size_t e = 0; e < NUM_EPOCHS; ++e) {
+    /// the lazy cell is only touched every third epoch
+    for (std::size_t i = 0; i < SAMPLES_PER_EPOCH; ++i) {
+      samples.emplace_back(rng.get());
+      epochs.emplace_back(e);
+      eager.add(samples.back(), clock);
+      if (e % 3 == 0) lazy.add(samples.back(), clock);
+    }
+    clock.step();
+    eager.decay(clock);
+  }
+
+  /// explicitly forgotten reference
+  weighted_t reference;
+  weighted_t lazy_reference;
+  for (std::size_t i = 0; i < samples.size(); ++i) {
+    const double w = std::pow(FACTOR, double(NUM_EPOCHS - epochs[i]));
+    reference.add(samples[i], w);
+    if (epochs[i] % 3 == 0) lazy_reference.add(samples[i], w);
+  }
+
+  EXPECT_NEAR(reference.getWeight(), eager.getWeight(clock), 1e-9);
+  EXPECT_NEAR(reference.getWeightSQ(),
+              eager.getDistribution().getWeightSQ(), 1e-9);
+  EXPECT_TRUE(reference.getMean().isApprox(eager.getDistribution().getMean(),
+                                           1e-9));
+  EXPECT_TRUE(reference.getCovariance().isApprox(
+      eager.getDistribution().getCovariance(), 1e-9));
+
+  EXPECT_NEAR(lazy_reference.getWeight(), lazy.getWeight(clock), 1e-9);
+  EXPECT_LT(lazy.getEpoch(), clock.getEpoch());
+  lazy.decay(clock);
+  EXPECT_EQ(clock.getEpoch(), lazy.getEpoch());
+  EXPECT_NEAR(lazy_reference.getWeight(),
+              lazy.getDistribution().getWeight(), 1e-9);
+  EXPECT_NEAR(lazy_reference.getWeightSQ(),
+              lazy.getDistribution().getWeightSQ(), 1e-9);
+  EXPECT_TRUE(lazy_reference.getCovariance().isApprox(
+      lazy.getDistribution().getCovariance(), 1e-9));
+
+  /// merging ages both sides to the current epoch
+  decaying_t merged;
+  merged.merge(lazy, clock);
+  merged.merge(eager, clock);
+  EXPECT_NEAR(lazy_reference.getWeight() + reference.getWeight(),
+              merged.getWeight(clock), 1e-9);
+}
+
+TEST(Test_cslibs_math, testDecayingDistribution) {
+  testDecay<2>();
+  testDecay<3>();
+}
+
+TEST(Test_cslibs_math, testDecayingDistributionNewEvidence) {
+  /// without forgetting the mean saturates, with forgetting it follows
+  using decaying_t = cslibs_math::statistics::DecayingDistribution<double, 1>;
+  decaying_t::decay_clock_t forgetting(0.5);
+  decaying_t::decay_clock_t keeping(1.0);
+  decaying_t a;
+  decaying_t b;
+  for (std::size_t e = 0; e < NUM_EPOCHS; ++e) {
+    const double s = e < NUM_EPOCHS / 2 ? 0.0 : 10.0;
+    for (std::size_t i = 0; i < SAMPLES_PER_EPOCH; ++i) {
+      a.add(s + 0.01 * double(i), forgetting);
+      b.add(s + 0.01 * double(i), keeping);
+    }
+    forgetting.step();
+    keeping.step();
+  }
+  EXPECT_NEAR(10.0, a.getDistribution().getMean(), 0.1);
+  EXPECT_NEAR(5.0, b.getDistribution().getMean(), 0.1);
+  EXPECT_NEAR(double(NUM_EPOCHS * SAMPLES_PER_EPOCH), b.getWeight(keeping),
+              1e-9);
+}
+
+TEST(Test_cslibs_math, testDecayingDistributionUnderflow) {
+  using decaying_t = cslibs_math::statistics::DecayingDistribution<double, 2>;
+  decaying_t::decay_clock_t clock(0.0);
+  decaying_t d;
+  for (std::size_t i = 0; i < SAMPLES_PER_EPOCH; ++i)
+    d.add(Eigen::Vector2d::Constant(double(i)), clock);
+  EXPECT_TRUE(d.valid());
+  clock.step();
+  d.decay(clock);
+  EXPECT_FALSE(d.valid());
+  EXPECT_EQ(0.0, d.getDistribution().getWeight());
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
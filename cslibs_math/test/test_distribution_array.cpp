@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/distribution_array.hpp>
+
+const std::size_t CELLS = 100;
+const std::size_t MAX_SAMPLES = 50;
+
+/// cells with a few samples have nearly singular covariances, the entries of
+/// their inverses are large, so compare relative to the magnitude
+double tolerance(const double expected) {
+  return 1e-9 * std::max(1.0, std::abs(expected));
+}
+
+template <std::size_t Dim>
+using rng_t = cslibs_math::random::Uniform<double, Dim>;
+
+template <std::size_t Dim>
+void testDimension() {
+  using distribution_t = cslibs_math::statistics::Distribution<double, Dim>;
+  using array_t = cslibs_math::statistics::DistributionArray<double, Dim>;
+  using sample_t = typename distribution_t::sample_t;
+
+  rng_t<Dim> rng(sample_t::Constant(-10.0), sample_t::Constant(10.0), 42);
+  rng_t<1> rng_samples(0.0, static_cast<double>(MAX_SAMPLES), 43);
+
+  std::vector<distribution_t, typename distribution_t::allocator_t> reference(
+      CELLS);
+  array_t array(CELLS);
+  EXPECT_EQ(CELLS, array.size());
+
+  for (std::size_t c = 0; c < CELLS; ++c) {
+    const std::size_t n = static_cast<std::size_t>(rng_samples.get());
+    for (std::size_t s = 0; s < n; ++s) {
+      const sample_t p = rng.get();
+      reference[c].add(p);
+      array.add(c, p);
+    }
+  }
+
+  auto compare = [&](const bool bulk) {
+    if (bulk) array.updateAll();
+    for (std::size_t c = 0; c < CELLS; ++c) {
+      const distribution_t &d = reference[c];
+      EXPECT_EQ(d.getN(), array.getN(c));
+      EXPECT_EQ(d.valid(), array.valid(c));
+      for (std::size_t i = 0; i < Dim; ++i) {
+        EXPECT_NEAR(d.getMean()(i), array.getMean(c)(i), 1e-9);
+      }
+      if (!d.valid()) continue;
+
+      const auto cov = d.getCovariance();
+      const auto inf = d.getInformationMatrix();
+      for (std::size_t i = 0; i < Dim; ++i) {
+        for (std::size_t j = 0; j < Dim; ++j) {
+          EXPECT_NEAR(cov(i, j), array.getCovariance(c)(i, j),
+                      tolerance(cov(i, j)));
+          EXPECT_NEAR(inf(i, j), array.getInformationMatrix(c)(i, j),
+                      tolerance(inf(i, j)));
+        }
+      }
+      const sample_t p = rng.get();
+      EXPECT_NEAR(d.sample(p), array.sample(c, p), tolerance(d.sample(p)));
+      EXPECT_NEAR(d.sampleNonNormalized(p), array.sampleNonNormalized(c, p),
+                  tolerance(d.sampleNonNormalized(p)));
+      EXPECT_NEAR(d.denominator(), array.denominator(c),
+                  tolerance(d.denominator()));
+    }
+  };
+  compare(true);
+
+  /// merging and resetting single cells
+  for (std::size_t c = 0; c + 1 < CELLS; c += 2) {
+    reference[c] += reference[c + 1];
+    array.merge(c, array, c + 1);
+    reference[c + 1].reset();
+    array.reset(c + 1);
+  }
+  compare(false);
+
+  for (std::size_t c = 0; c < CELLS; ++c) {
+    const distribution_t d = array.getDistribution(c);
+    EXPECT_EQ(reference[c].getN(), d.getN());
+    if (d.valid()) {
+      const double trace = reference[c].getCovariance().trace();
+      EXPECT_NEAR(trace, d.getCovariance().trace(), tolerance(trace));
+    }
+  }
+}
+
+TEST(Test_cslibs_math, testDistributionArray2D) { testDimension<2>(); }
+
+TEST(Test_cslibs_math, testDistributionArray3D) { testDimension<3>(); }
+
+TEST(Test_cslibs_math, testDistributionArray4D) { testDimension<4>(); }
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <cslibs_math/statistics/stable_weighted_distribution.hpp>
+#include <cslibs_math/statistics/weighted_distribution.hpp>
+
+const std::size_t REPETITIONS = 20;
+const std::size_t NUM_SAMPLES = 1000;
+
+template <std::size_t Dim>
+using samples_t =
+    std::vector<Eigen::Matrix<double, Dim, 1>,
+                Eigen::aligned_allocator<Eigen::Matrix<double, Dim, 1>>>;
+
+template <std::size_t Dim>
+samples_t<Dim> randomSamples(std::vector<double> &weights) {
+  using sample_t = Eigen::Matrix<double, Dim, 1>;
+  cslibs_math::random::Uniform<double, Dim> rng(sample_t::Constant(-10.0),
+                                                sample_t::Constant(10.0));
+  cslibs_math::random::Uniform<double, 1> rng_w(-0.1, 1.0);
+
+  samples_t<Dim> samples(NUM_SAMPLES);
+  weights.resize(NUM_SAMPLES);
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) {
+    samples[i] = rng.get();
+    weights[i] = rng_w.get();
+  }
+  return samples;
+}
+
+template <std::size_t Dim>
+Eigen::Matrix<double, Dim, Eigen::Dynamic> toMatrix(
+    const samples_t<Dim> &samples) {
+  Eigen::Matrix<double, Dim, Eigen::Dynamic> m(Dim, samples.size());
+  for (std::size_t i = 0; i < samples.size(); ++i) m.col(i) = samples[i];
+  return m;
+}
+
+template <typename Ta, typename Tb>
+void expectNear(const Ta &a, const Tb &b, const double eps) {
+  EXPECT_NEAR(0.0, (a - b).cwiseAbs().maxCoeff(), eps);
+}
+
+template <std::size_t Dim>
+void testDistribution() {
+  using distribution_t = cslibs_math::statistics::Distribution<double, Dim>;
+  std::vector<double> weights;
+  for (std::size_t r = 0; r < REPETITIONS; ++r) {
+    const samples_t<Dim> samples = randomSamples<Dim>(weights);
+    const std::size_t half = NUM_SAMPLES / 2;
+
+    distribution_t sequential;
+    for (const auto &p : samples) sequential.add(p);
+
+    /// two batches, the second one is folded into existing statistics
+    distribution_t batch;
+    batch.add(samples.begin(), samples.begin() + half);
+    batch.add(samples.begin() + half, samples.end());
+
+    distribution_t matrix;
+    matrix.add(toMatrix<Dim>(samples));
+
+    for (const distribution_t *d : {&batch, &matrix}) {
+      EXPECT_EQ(sequential.getN(), d->getN());
+      expectNear(sequential.getMean(), d->getMean(), 1e-9);
+      expectNear(sequential.getCovariance(), d->getCovariance(), 1e-8);
+    }
+
+    /// empty batches do not change anything
+    batch.add(samples.end(), samples.end());
+    EXPECT_EQ(sequential.getN(), batch.getN());
+  }
+}
+
+template <typename distribution_t, std::size_t Dim>
+void testWeightedDistribution() {
+  std::vector<double> weights;
+  for (std::size_t r = 0; r < REPETITIONS; ++r) {
+    const samples_t<Dim> samples = randomSamples<Dim>(weights);
+    const std::size_t half = NUM_SAMPLES / 2;
+
+    distribution_t sequential;
+    for (std::size_t i = 0; i < NUM_SAMPLES; ++i)
+      sequential.add(samples[i], weights[i]);
+
+    distribution_t batch;
+    batch.add(samples.begin(), samples.begin() + half, weights.begin());
+    batch.add(samples.begin() + half, samples.end(), weights.begin() + half);
+
+    distribution_t matrix;
+    matrix.add(toMatrix<Dim>(samples),
+               Eigen::Map<const Eigen::VectorXd>(weights.data(),
+                                                 weights.size()));
+
+    for (const distribution_t *d : {&batch, &matrix}) {
+      EXPECT_EQ(sequential.getSampleCount(), d->getSampleCount());
+      EXPECT_NEAR(sequential.getWeight(), d->getWeight(), 1e-9);
+      EXPECT_NEAR(sequential.getWeightSQ(), d->getWeightSQ(), 1e-9);
+      expectNear(sequential.getMean(), d->getMean(), 1e-9);
+      expectNear(sequential.getCovariance(), d->getCovariance(), 1e-8);
+    }
+  }
+}
+
+TEST(Test_cslibs_math, testDistributionBatch) {
+  testDistribution<2>();
+  testDistribution<3>();
+}
+
+TEST(Test_cslibs_math, testWeightedDistributionBatch) {
+  using namespace cslibs_math::statistics;
+  testWeightedDistribution<WeightedDistribution<double, 2>, 2>();
+  testWeightedDistribution<WeightedDistribution<double, 3>, 3>();
+}
+
+TEST(Test_cslibs_math, testStableWeightedDistributionBatch) {
+  using namespace cslibs_math::statistics;
+  testWeightedDistribution<StableWeightedDistribution<double, 2>, 2>();
+  testWeightedDistribution<StableWeightedDistribution<double, 3>, 3>();
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
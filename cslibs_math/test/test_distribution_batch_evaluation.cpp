@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <cslibs_math/statistics/weighted_distribution.hpp>
+
+const std::size_t NUM_SAMPLES = 100;
+const std::size_t NUM_POINTS = 1000;
+
+template <typename distribution_t>
+void add(distribution_t &d, const typename distribution_t::sample_t &p) {
+  d.add(p);
+}
+
+template <typename T, std::size_t Dim>
+void add(cslibs_math::statistics::WeightedDistribution<T, Dim> &d,
+         const typename cslibs_math::statistics::WeightedDistribution<
+             T, Dim>::sample_t &p) {
+  d.add(p, 0.5);
+}
+
+template <typename distribution_t, std::size_t Dim>
+void testBatchEvaluation() {
+  using sample_t = typename distribution_t::sample_t;
+  using samples_t = typename distribution_t::samples_t;
+  using densities_t = typename distribution_t::densities_t;
+
+  cslibs_math::random::Uniform<double, Dim> rng(sample_t::Constant(-10.0),
+                                                sample_t::Constant(10.0));
+  samples_t points(Dim, NUM_POINTS);
+  for (std::size_t i = 0; i < NUM_POINTS; ++i) points.col(i) = rng.get();
+
+  densities_t out;
+  distribution_t d;
+  d.sample(points, out);
+  ASSERT_EQ(static_cast<Eigen::Index>(NUM_POINTS), out.size());
+  EXPECT_TRUE((out == 0.0).all());
+  d.logSample(points, out);
+  EXPECT_TRUE((out == -std::numeric_limits<double>::infinity()).all());
+
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) add(d, rng.get());
+
+  /// batch evaluation on a dirty distribution has to update first
+  densities_t mahalanobis, sample, sample_nn, log_sample, log_sample_nn;
+  d.mahalanobis(points, mahalanobis);
+  d.sample(points, sample);
+  d.sampleNonNormalized(points, sample_nn);
+  d.logSample(points, log_sample);
+  d.logSampleNonNormalized(points, log_sample_nn);
+
+  const auto information = d.getInformationMatrix();
+  for (std::size_t i = 0; i < NUM_POINTS; ++i) {
+    const sample_t p = points.col(i);
+    const sample_t q = p - d.getMean();
+    EXPECT_NEAR(q.dot(information * q), mahalanobis(i), 1e-9);
+    EXPECT_NEAR(d.sample(p), sample(i), 1e-12);
+    EXPECT_NEAR(d.sampleNonNormalized(p), sample_nn(i), 1e-12);
+    EXPECT_NEAR(d.logSample(p), log_sample(i), 1e-9);
+    EXPECT_NEAR(d.logSampleNonNormalized(p), log_sample_nn(i), 1e-9);
+  }
+}
+
+TEST(Test_cslibs_math, testDistributionBatchEvaluation) {
+  using namespace cslibs_math::statistics;
+  testBatchEvaluation<Distribution<double, 2>, 2>();
+  testBatchEvaluation<Distribution<double, 3>, 3>();
+}
+
+TEST(Test_cslibs_math, testWeightedDistributionBatchEvaluation) {
+  using namespace cslibs_math::statistics;
+  testBatchEvaluation<WeightedDistribution<double, 2>, 2>();
+  testBatchEvaluation<WeightedDistribution<double, 3>, 3>();
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
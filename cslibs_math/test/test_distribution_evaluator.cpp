@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <thread>
+
+const std::size_t NUM_SAMPLES = 100;
+const std::size_t NUM_QUERIES = 1000;
+
+template <std::size_t Dim>
+void testEvaluator() {
+  using distribution_t = cslibs_math::statistics::Distribution<double, Dim>;
+  using sample_t = typename distribution_t::sample_t;
+  cslibs_math::random::Uniform<double, Dim> rng(sample_t::Constant(-10.0),
+                                                sample_t::Constant(10.0));
+
+  distribution_t d;
+  EXPECT_FALSE(d.freeze().valid());
+  EXPECT_EQ(0.0, d.freeze().sample(sample_t::Zero()));
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(),
+            d.freeze().logLikelihood(sample_t::Zero()));
+
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) d.add(rng.get());
+  const typename distribution_t::Evaluator e = d.freeze();
+  ASSERT_TRUE(e.valid());
+  EXPECT_NEAR(d.denominator(), e.denominator(), 1e-12);
+
+  std::vector<sample_t, Eigen::aligned_allocator<sample_t>> queries(
+      NUM_QUERIES);
+  std::vector<double> expected(NUM_QUERIES);
+  for (std::size_t i = 0; i < NUM_QUERIES; ++i) {
+    queries[i] = rng.get();
+    expected[i] = d.sample(queries[i]);
+    EXPECT_NEAR(expected[i], e.sample(queries[i]), 1e-12);
+    EXPECT_NEAR(d.sampleNonNormalized(queries[i]),
+                e.sampleNonNormalized(queries[i]), 1e-12);
+    if (expected[i] > 0.0) {
+      EXPECT_NEAR(std::log(expected[i]), e.logLikelihood(queries[i]), 1e-9);
+    }
+  }
+
+  /// concurrent evaluation on the same snapshot
+  const std::size_t threads = 4;
+  std::vector<double> results(NUM_QUERIES);
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      for (std::size_t i = t; i < NUM_QUERIES; i += threads)
+        results[i] = e.sample(queries[i]);
+    });
+  }
+  for (auto &w : workers) w.join();
+  for (std::size_t i = 0; i < NUM_QUERIES; ++i)
+    EXPECT_NEAR(expected[i], results[i], 1e-12);
+
+  /// the snapshot is not affected by later modification
+  d.add(rng.get());
+  EXPECT_NEAR(expected.front(), e.sample(queries.front()), 1e-12);
+}
+
+TEST(Test_cslibs_math, testDistributionEvaluator1D) {
+  cslibs_math::statistics::Distribution<double, 1> d;
+  EXPECT_FALSE(d.freeze().valid());
+
+  cslibs_math::random::Uniform<double, 1> rng(-10.0, 10.0);
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) d.add(rng.get());
+  const auto e = d.freeze();
+  for (std::size_t i = 0; i < NUM_QUERIES; ++i) {
+    const double s = rng.get();
+    EXPECT_NEAR(d.sample(s), e.sample(s), 1e-12);
+    EXPECT_NEAR(d.sampleNonNormalized(s), e.sampleNonNormalized(s), 1e-12);
+    EXPECT_NEAR(std::log(d.sample(s)), e.logLikelihood(s), 1e-9);
+  }
+}
+
+TEST(Test_cslibs_math, testDistributionEvaluator2D) { testEvaluator<2>(); }
+
+TEST(Test_cslibs_math, testDistributionEvaluator3D) { testEvaluator<3>(); }
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <cslibs_math/statistics/stable_distribution.hpp>
+#include <cslibs_math/statistics/stable_weighted_distribution.hpp>
+#include <cslibs_math/statistics/weighted_distribution.hpp>
+
+const std::size_t NUM_SAMPLES = 100;
+const std::size_t NUM_QUERIES = 100;
+
+template <std::size_t Dim>
+struct Sampler {
+  using sample_t = Eigen::Matrix<double, Dim, 1>;
+  Sampler() : rng(sample_t::Constant(-10.0), sample_t::Constant(10.0)) {}
+  sample_t get() { return rng.get(); }
+  sample_t far() { return sample_t::Constant(1e3); }
+  cslibs_math::random::Uniform<double, Dim> rng;
+};
+
+template <>
+struct Sampler<1> {
+  Sampler() : rng(-10.0, 10.0) {}
+  double get() { return rng.get(); }
+  double far() { return 1e3; }
+  cslibs_math::random::Uniform<double, 1> rng;
+};
+
+/// weighted distributions get a constant weight
+template <typename distribution_t>
+struct Add {
+  template <typename sample_t>
+  static void apply(distribution_t &d, const sample_t &s) {
+    d.add(s);
+  }
+};
+template <typename T, std::size_t Dim>
+struct Add<cslibs_math::statistics::WeightedDistribution<T, Dim>> {
+  template <typename sample_t>
+  static void apply(cslibs_math::statistics::WeightedDistribution<T, Dim> &d,
+                    const sample_t &s) {
+    d.add(s, 0.5);
+  }
+};
+template <typename T, std::size_t Dim>
+struct Add<cslibs_math::statistics::StableWeightedDistribution<T, Dim>> {
+  template <typename sample_t>
+  static void apply(
+      cslibs_math::statistics::StableWeightedDistribution<T, Dim> &d,
+      const sample_t &s) {
+    d.add(s, 0.5);
+  }
+};
+
+/// checks logSampleNonNormalized against sampleNonNormalized
+template <typename distribution_t, std::size_t Dim>
+distribution_t testNonNormalized() {
+  Sampler<Dim> rng;
+  distribution_t d;
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(),
+            d.logSampleNonNormalized(rng.get()));
+
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i)
+    Add<distribution_t>::apply(d, rng.get());
+  for (std::size_t i = 0; i < NUM_QUERIES; ++i) {
+    const auto p = rng.get();
+    EXPECT_NEAR(std::log(d.sampleNonNormalized(p)),
+                d.logSampleNonNormalized(p), 1e-9);
+  }
+
+  /// far outside, the density underflows, the log-density does not
+  EXPECT_EQ(0.0, d.sampleNonNormalized(rng.far()));
+  EXPECT_TRUE(std::isfinite(d.logSampleNonNormalized(rng.far())));
+  return d;
+}
+
+/// additionally checks logSample against sample
+template <typename distribution_t, std::size_t Dim>
+void testNormalized() {
+  Sampler<Dim> rng;
+  const distribution_t d = testNonNormalized<distribution_t, Dim>();
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(),
+            distribution_t().logSample(rng.get()));
+  for (std::size_t i = 0; i < NUM_QUERIES; ++i) {
+    const auto p = rng.get();
+    EXPECT_NEAR(std::log(d.sample(p)), d.logSample(p), 1e-9);
+  }
+  EXPECT_TRUE(std::isfinite(d.logSample(rng.far())));
+}
+
+TEST(Test_cslibs_math, testDistributionLogSample) {
+  using namespace cslibs_math::statistics;
+  testNormalized<Distribution<double, 1>, 1>();
+  testNormalized<Distribution<double, 2>, 2>();
+  testNormalized<Distribution<double, 3>, 3>();
+  testNormalized<Distribution<double, 4>, 4>();
+}
+
+TEST(Test_cslibs_math, testWeightedDistributionLogSample) {
+  using namespace cslibs_math::statistics;
+  testNormalized<WeightedDistribution<double, 1>, 1>();
+  testNormalized<WeightedDistribution<double, 2>, 2>();
+  testNormalized<WeightedDistribution<double, 3>, 3>();
+}
+
+TEST(Test_cslibs_math, testStableDistributionLogSample) {
+  using namespace cslibs_math::statistics;
+  testNormalized<StableDistribution<double, 1>, 1>();
+  testNonNormalized<StableDistribution<double, 2>, 2>();
+  testNonNormalized<StableDistribution<double, 3>, 3>();
+  testNormalized<StableWeightedDistribution<double, 1>, 1>();
+  testNonNormalized<StableWeightedDistribution<double, 2>, 2>();
+  testNonNormalized<StableWeightedDistribution<double, 3>, 3>();
+}
+
+TEST(Test_cslibs_math, testDistributionCholeskyInverse) {
+  using distribution_t = cslibs_math::statistics::Distribution<double, 4>;
+  Sampler<4> rng;
+  distribution_t d;
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) d.add(rng.get());
+
+  using covariance_t = distribution_t::covariance_t;
+  const covariance_t covariance = d.getCovariance();
+  const covariance_t identity = covariance * d.getInformationMatrix();
+  EXPECT_NEAR(0.0,
+              (identity - covariance_t::Identity()).cwiseAbs().maxCoeff(),
+              1e-9);
+
+  const double determinant = covariance.determinant();
+  EXPECT_NEAR(determinant,
+              1.0 / (d.denominator() * distribution_t::sqrt_2_M_PI),
+              1e-6 * determinant);
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
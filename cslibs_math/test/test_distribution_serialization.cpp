@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <cslibs_math/random/random.hpp>
+#include <cslibs_math/serialization/compact_distribution.hpp>
 #include <cslibs_math/serialization/distribution.hpp>
+#include <cslibs_math/serialization/stable_distribution.hpp>
+#include <cstdio>
 
 const std::size_t MIN_DIMENSION = 1;
 const std::size_t MAX_DIMENSION = 3;
@@ -111,6 +114,73 @@ TEST(Test_cslibs_math, testDistributionSerialization) {
   Loop<MIN_DIMENSION, MAX_DIMENSION>::iterate<TestDimension>();
 }
 
+TEST(Test_cslibs_math, testStableDistributionSerialization) {
+  using distribution_t =
+      cslibs_math::statistics::StableDistribution<double, 3>;
+  using distribution_1d_t =
+      cslibs_math::statistics::StableDistribution<double, 1>;
+  rng_t<3> rng(Eigen::Vector3d::Constant(-100.0),
+               Eigen::Vector3d::Constant(100.0));
+  rng_t<1> rng_1d(-100.0, 100.0);
+
+  distribution_t d;
+  distribution_1d_t d_1d;
+  for (std::size_t n = 0; n < MIN_NUM_SAMPLES; ++n) {
+    d.add(rng.get());
+    d_1d.add(rng_1d.get());
+  }
+
+  const distribution_t d_converted = YAML::Node(d).as<distribution_t>();
+  EXPECT_EQ(d.getN(), d_converted.getN());
+  EXPECT_TRUE(d.getMean().isApprox(d_converted.getMean(), 1e-9));
+  EXPECT_TRUE(d.getScatter().isApprox(d_converted.getScatter(), 1e-9));
+
+  const distribution_1d_t d_1d_converted =
+      YAML::Node(d_1d).as<distribution_1d_t>();
+  EXPECT_EQ(d_1d.getN(), d_1d_converted.getN());
+  EXPECT_NEAR(d_1d.getMean(), d_1d_converted.getMean(), 1e-9);
+  EXPECT_NEAR(d_1d.getVariance(), d_1d_converted.getVariance(), 1e-9);
+}
+
+TEST(Test_cslibs_math, testCompactDistributionSerialization) {
+  using distribution_t =
+      cslibs_math::statistics::CompactDistribution<double, 3>;
+  using binary_t = cslibs_math::serialization::binary<
+      cslibs_math::statistics::CompactDistribution, double, 3, 0>;
+  rng_t<3> rng(Eigen::Vector3d::Constant(-100.0),
+               Eigen::Vector3d::Constant(100.0));
+
+  distribution_t d;
+  for (std::size_t n = 0; n < MIN_NUM_SAMPLES; ++n) d.add(rng.get());
+
+  // yaml
+  const distribution_t d_converted = YAML::Node(d).as<distribution_t>();
+  EXPECT_EQ(d.getN(), d_converted.getN());
+  EXPECT_TRUE(d.getMean().isApprox(d_converted.getMean(), 1e-9));
+  EXPECT_TRUE(d.getScatter().isApprox(d_converted.getScatter(), 1e-9));
+
+  // binary
+  const std::string path =
+      testing::TempDir() + "test_compact_distribution.bin";
+  {
+    std::ofstream out(path, std::ios::binary);
+    binary_t::write(d, out);
+    binary_t::write(out);
+  }
+  distribution_t d_read;
+  distribution_t d_empty(d);
+  {
+    std::ifstream in(path, std::ios::binary);
+    EXPECT_EQ(std::size_t(binary_t::size), binary_t::read(in, d_read));
+    EXPECT_EQ(sizeof(std::size_t), binary_t::read(in, d_empty));
+  }
+  std::remove(path.c_str());
+  EXPECT_EQ(d.getN(), d_read.getN());
+  EXPECT_EQ(d.getMean(), d_read.getMean());
+  EXPECT_EQ(d.getScatter(), d_read.getScatter());
+  EXPECT_EQ(0ul, d_empty.getN());
+}
+
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
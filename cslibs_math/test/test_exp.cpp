@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/approx/exp.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <vector>
+
+using cslibs_math::approx::ExpAccuracy;
+const std::size_t SAMPLES = 100003;
+
+template <typename T, ExpAccuracy Accuracy>
+void testExp(const T min, const T max, const double bound) {
+  cslibs_math::random::Uniform<double, 1> rng(min, max, 42);
+  std::vector<T> in(SAMPLES);
+  for (T &v : in) v = static_cast<T>(rng.get());
+  /// exact powers of two and the origin
+  in[0] = T(0);
+  in[1] = T(-M_LN2);
+  in[2] = T(M_LN2 * 10.0);
+
+  std::vector<T> out(SAMPLES);
+  cslibs_math::approx::exp<Accuracy>(in.data(), out.data(), in.size());
+  double max_error = 0.0;
+  for (std::size_t i = 0; i < SAMPLES; ++i) {
+    const double expected = std::exp(static_cast<double>(in[i]));
+    const double error = std::abs(out[i] / expected - 1.0);
+    max_error = std::max(max_error, error);
+    /// the packet and the scalar kernel are the same
+    EXPECT_EQ(out[i], cslibs_math::approx::exp<Accuracy>(in[i]));
+  }
+  EXPECT_LT(max_error, bound);
+
+  /// in place, remainder shorter than a packet
+  std::vector<T> inplace(in.begin(), in.begin() + 3);
+  cslibs_math::approx::exp<Accuracy>(inplace.data(), inplace.data(), 3);
+  for (std::size_t i = 0; i < 3; ++i) EXPECT_EQ(out[i], inplace[i]);
+}
+
+template <typename T, ExpAccuracy Accuracy>
+void testExpLimits() {
+  const T low = static_cast<T>(-1000.0);
+  const T high = static_cast<T>(1000.0);
+  EXPECT_EQ(T(0), cslibs_math::approx::exp<Accuracy>(low));
+  EXPECT_GT(cslibs_math::approx::exp<Accuracy>(high),
+            std::numeric_limits<T>::max() / T(2));
+  EXPECT_NEAR(1.0, cslibs_math::approx::exp<Accuracy>(T(0)), 1e-4);
+}
+
+TEST(Test_cslibs_math, testExpFloat) {
+  testExp<float, ExpAccuracy::Coarse>(-80.0f, 80.0f, 1e-4);
+  testExp<float, ExpAccuracy::Fine>(-80.0f, 80.0f, 1e-6);
+  testExp<float, ExpAccuracy::Full>(-80.0f, 80.0f, 5e-7);
+  testExpLimits<float, ExpAccuracy::Coarse>();
+  testExpLimits<float, ExpAccuracy::Full>();
+}
+
+TEST(Test_cslibs_math, testExpDouble) {
+  testExp<double, ExpAccuracy::Coarse>(-700.0, 700.0, 1e-4);
+  testExp<double, ExpAccuracy::Fine>(-700.0, 700.0, 1e-7);
+  testExp<double, ExpAccuracy::Full>(-700.0, 700.0, 1e-14);
+  testExpLimits<double, ExpAccuracy::Coarse>();
+  testExpLimits<double, ExpAccuracy::Full>();
+}
+
+TEST(Test_cslibs_math, testExpLimitForm) {
+  EXPECT_NEAR(std::exp(-1.0), (cslibs_math::approx::exp<20, double>(-1.0)),
+              1e-6);
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -2,6 +2,7 @@
 
 #include <cslibs_math/approx/fractional.hpp>
 #include <cslibs_math/random/random.hpp>
+#include <vector>
 
 using Fractionald = cslibs_math::approx::Fractional<double>;
 
@@ -92,6 +93,77 @@ TEST(Test_cslibs_math, testSub) {
   }
 }
 
+TEST(Test_cslibs_math, testCompare) {
+  rng_t rng(-100.0, 100.0);
+  for (std::size_t i = 0; i < REPETITIONS; ++i) {
+    const auto a = rng.get();
+    const auto b = rng.get() * 1e-3;
+    const bool less = Fractionald(a) < Fractionald(b);
+    const bool greater = Fractionald(b) < Fractionald(a);
+    EXPECT_EQ(a < b, less);
+    EXPECT_EQ(b < a, greater);
+    EXPECT_TRUE(Fractionald(a) == Fractionald(a));
+    EXPECT_FALSE(Fractionald(a) == Fractionald(b));
+  }
+  /// sums are not normalized
+  const Fractionald sum = Fractionald(0.75) + Fractionald(0.75);
+  EXPECT_TRUE(sum == Fractionald(1.5));
+  EXPECT_TRUE(Fractionald(1.25) < sum);
+  EXPECT_TRUE(Fractionald(0.0) < Fractionald(1e-300));
+  EXPECT_TRUE(Fractionald(-1e-300) < Fractionald(0.0));
+  EXPECT_TRUE(Fractionald(-4.0) < Fractionald(-2.0));
+  EXPECT_FALSE(Fractionald(0.0) < Fractionald(0.0));
+}
+
+template <typename T, std::size_t Interval>
+void testFractionalProduct(const double min, const double bound) {
+  using product_t = cslibs_math::approx::FractionalProduct<T, Interval>;
+  rng_t rng(min, 1.0);
+  std::vector<T> factors(2003);
+  double expected = 0.0;
+  for (T &f : factors) {
+    f = static_cast<T>(rng.get());
+    expected += std::log(static_cast<double>(f));
+  }
+
+  product_t bulk;
+  bulk.multiply(factors.data(), factors.size());
+  product_t scalar;
+  for (const T f : factors) scalar *= f;
+  /// far below the smallest normal number, but representable as fractional
+  EXPECT_LT(expected, std::log(std::numeric_limits<double>::min()));
+  EXPECT_NEAR(expected, bulk.log(), bound * std::abs(expected));
+  EXPECT_NEAR(expected, scalar.log(), bound * std::abs(expected));
+
+  /// split calls continue the same product
+  product_t split;
+  split.multiply(factors.data(), 5);
+  split.multiply(factors.data() + 5, factors.size() - 5);
+  EXPECT_NEAR(bulk.log(), split.log(), bound * std::abs(expected));
+
+  /// small products are exact up to rounding
+  product_t small;
+  small.multiply(factors.data(), 3);
+  EXPECT_NEAR(static_cast<double>(factors[0] * factors[1] * factors[2]),
+              small.value(), 1e-6);
+
+  factors[1000] = T(0);
+  bulk.reset();
+  bulk.multiply(factors.data(), factors.size());
+  EXPECT_EQ(T(0), bulk.value());
+  EXPECT_EQ(0, bulk.get().exponent());
+
+  bulk.reset();
+  EXPECT_EQ(T(1), bulk.value());
+}
+
+TEST(Test_cslibs_math, testFractionalProduct) {
+  testFractionalProduct<double, 8>(1e-3, 1e-12);
+  testFractionalProduct<double, 1>(1e-3, 1e-12);
+  testFractionalProduct<float, 8>(1e-3, 1e-5);
+  testFractionalProduct<float, 3>(1e-3, 1e-5);
+}
+
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <cslibs_math/statistics/gaussian_mixture.hpp>
+
+using mixture_t = cslibs_math::statistics::GaussianMixture<double, 2>;
+using sample_t = mixture_t::sample_t;
+using samples_t = mixture_t::samples_t;
+using covariance_t = Eigen::Matrix2d;
+
+const std::size_t NUM_SAMPLES = 3000;
+
+/// three well separated clusters holding 1/6, 2/6 and 3/6 of the samples
+samples_t clusters(std::vector<sample_t, Eigen::aligned_allocator<sample_t>>
+                       &means) {
+  means = {sample_t(-10.0, 0.0), sample_t(0.0, 10.0), sample_t(10.0, 0.0)};
+  covariance_t covariance;
+  covariance << 1.0, 0.3, 0.3, 0.5;
+
+  samples_t samples(2, NUM_SAMPLES);
+  Eigen::Index c = 0;
+  for (std::size_t k = 0; k < means.size(); ++k) {
+    cslibs_math::random::Normal<double, 2> rng(means[k], covariance, 42 + k);
+    for (std::size_t i = 0; i < (k + 1) * NUM_SAMPLES / 6; ++i)
+      samples.col(c++) = rng.get();
+  }
+  return samples;
+}
+
+TEST(Test_cslibs_math, testGaussianMixtureFit) {
+  std::vector<sample_t, Eigen::aligned_allocator<sample_t>> means;
+  const samples_t samples = clusters(means);
+
+  mixture_t mixture;
+  mixture.initialize(samples, 3, 1);
+  ASSERT_EQ(3ul, mixture.size());
+  const std::size_t iterations = mixture.fit(samples, 100, 1e-8, 1);
+  EXPECT_GT(iterations, 0ul);
+  EXPECT_LT(iterations, 100ul);
+
+  double weights = 0.0;
+  Eigen::Index first = 0;
+  for (std::size_t k = 0; k < means.size(); ++k) {
+    /// the clusters are separated well, the responsibilities are binary
+    const Eigen::Index n = (k + 1) * NUM_SAMPLES / 6;
+    cslibs_math::statistics::Distribution<double, 2> cluster;
+    cluster.add(Eigen::Matrix<double, 2, Eigen::Dynamic>(
+        samples.middleCols(first, n)));
+    first += n;
+
+    std::size_t nearest = 0;
+    for (std::size_t c = 1; c < mixture.size(); ++c) {
+      if ((mixture.getComponent(c).getMean() - means[k]).norm() <
+          (mixture.getComponent(nearest).getMean() - means[k]).norm())
+        nearest = c;
+    }
+    const auto &component = mixture.getComponent(nearest);
+    EXPECT_NEAR(0.0, (component.getMean() - means[k]).norm(), 0.1);
+    EXPECT_NEAR(0.0, (component.getMean() - cluster.getMean()).norm(), 1e-6);
+    EXPECT_NEAR(0.0,
+                (component.getCovariance() - cluster.getCovariance())
+                    .cwiseAbs()
+                    .maxCoeff(),
+                1e-6);
+    EXPECT_NEAR((k + 1) / 6.0, mixture.getWeight(nearest), 1e-3);
+    weights += mixture.getWeight(nearest);
+  }
+  EXPECT_NEAR(1.0, weights, 1e-9);
+
+  /// more threads only change the order of summation
+  mixture_t parallel;
+  parallel.initialize(samples, 3, 4);
+  parallel.fit(samples, iterations, 0.0, 4);
+  EXPECT_NEAR(mixture.getLogLikelihood(), parallel.getLogLikelihood(), 1e-6);
+  for (std::size_t k = 0; k < mixture.size(); ++k) {
+    EXPECT_NEAR(0.0,
+                (mixture.getComponent(k).getMean() -
+                 parallel.getComponent(k).getMean())
+                    .norm(),
+                1e-6);
+  }
+}
+
+TEST(Test_cslibs_math, testGaussianMixtureEvaluation) {
+  std::vector<sample_t, Eigen::aligned_allocator<sample_t>> means;
+  const samples_t samples = clusters(means);
+
+  mixture_t mixture;
+  mixture.fit(samples.leftCols(100), 10, 1e-8, 1);
+  mixture.initialize(samples, 3, 1);
+  mixture.fit(samples, 10, 1e-8, 2);
+
+  mixture_t::densities_t log_densities;
+  mixture_t::densities_t densities;
+  mixture.logSample(samples, log_densities);
+  mixture.sample(samples, densities);
+  ASSERT_EQ(samples.cols(), log_densities.size());
+  for (Eigen::Index i = 0; i < samples.cols(); i += 97) {
+    const sample_t p = samples.col(i);
+    double expected = 0.0;
+    for (std::size_t k = 0; k < mixture.size(); ++k)
+      expected += mixture.getWeight(k) * mixture.getComponent(k).sample(p);
+    EXPECT_NEAR(std::log(expected), mixture.logSample(p), 1e-9);
+    EXPECT_NEAR(std::log(expected), log_densities(i), 1e-9);
+    EXPECT_NEAR(expected, densities(i), 1e-9 * expected);
+    EXPECT_NEAR(expected, mixture.sample(p), 1e-9 * expected);
+  }
+  EXPECT_NEAR(log_densities.mean(), mixture.getLogLikelihood(), 1e-3);
+
+  mixture_t empty;
+  EXPECT_EQ(0.0, empty.sample(sample_t::Zero()));
+  EXPECT_EQ(0ul, empty.fit(samples_t(2, 0)));
+}
+
+TEST(Test_cslibs_math, testGaussianMixtureMerge) {
+  std::vector<sample_t, Eigen::aligned_allocator<sample_t>> means;
+  const samples_t samples = clusters(means);
+
+  /// too many components split the clusters, merging joins the halves
+  mixture_t mixture;
+  mixture.initialize(samples, 12, 1);
+  mixture.fit(samples, 50, 1e-8, 1);
+  const std::size_t size = mixture.size();
+  EXPECT_GT(size, 3ul);
+  EXPECT_EQ(size - 3, mixture.mergeComponents(2.0));
+  EXPECT_EQ(3ul, mixture.size());
+
+  double weights = 0.0;
+  for (std::size_t k = 0; k < mixture.size(); ++k)
+    weights += mixture.getWeight(k);
+  EXPECT_NEAR(1.0, weights, 1e-9);
+  EXPECT_EQ(0ul, mixture.mergeComponents(2.0));
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/serialization/histogram.hpp>
+#include <cslibs_math/serialization/quantile_sketch.hpp>
+#include <limits>
+#include <list>
+
+const std::size_t NUM_SAMPLES = 100000;
+const std::size_t BINS = 50;
+
+template <typename T>
+void testHistogram() {
+  using histogram_t = cslibs_math::statistics::Histogram<T>;
+  cslibs_math::random::Uniform<T, 1> rng(-2.0, 12.0);
+  typename histogram_t::values_t values(NUM_SAMPLES);
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) values(i) = rng.get();
+  values(0) = 0.0;
+  values(1) = 10.0;
+  values(2) = -1e-6;
+
+  histogram_t single(0.0, 10.0, BINS);
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) single.add(values(i));
+
+  histogram_t batch(0.0, 10.0, BINS);
+  batch.add(values);
+  EXPECT_EQ(single.getCounts(), batch.getCounts());
+  EXPECT_EQ(single.getN(), batch.getN());
+
+  const std::list<T> list(values.data(), values.data() + NUM_SAMPLES);
+  histogram_t range(0.0, 10.0, BINS);
+  range.add(list.begin(), list.end());
+  EXPECT_EQ(single.getCounts(), range.getCounts());
+
+  std::size_t underflow = 0, overflow = 0;
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) {
+    underflow += values(i) < 0.0;
+    overflow += values(i) >= 10.0;
+  }
+  EXPECT_EQ(underflow, single.getUnderflow());
+  EXPECT_EQ(overflow, single.getOverflow());
+  EXPECT_EQ(1ul, single.getCount(0) > 0);
+
+  /// uniform over [-2, 12], the median is 5
+  EXPECT_NEAR(5.0, single.getQuantile(0.5), 0.1);
+  EXPECT_EQ(T(0.0), single.getQuantile(0.0));
+  EXPECT_EQ(T(10.0), single.getQuantile(1.0));
+
+  histogram_t merged(0.0, 10.0, BINS);
+  merged += single;
+  merged.merge(batch);
+  EXPECT_EQ(2 * NUM_SAMPLES, merged.getN());
+  for (std::size_t i = 0; i < BINS; ++i)
+    EXPECT_EQ(2 * single.getCount(i), merged.getCount(i));
+
+  merged.reset();
+  EXPECT_EQ(0ul, merged.getN());
+
+  histogram_t more_bins(0.0, 10.0, 2 * BINS);
+  histogram_t other_range(0.0, 20.0, BINS);
+  EXPECT_THROW(merged += more_bins, std::invalid_argument);
+  EXPECT_THROW(merged += other_range, std::invalid_argument);
+  EXPECT_EQ(0ul, merged.getN());
+}
+
+/// values far out of range are counted as underflow and overflow
+template <typename T>
+void testHistogramLimits(const T huge) {
+  using histogram_t = cslibs_math::statistics::Histogram<T>;
+  typename histogram_t::values_t values(4);
+  values << std::numeric_limits<T>::infinity(), huge,
+      -std::numeric_limits<T>::infinity(), -huge;
+
+  histogram_t single(0.0, 10.0, BINS);
+  for (Eigen::Index i = 0; i < values.size(); ++i) single.add(values(i));
+  EXPECT_EQ(2ul, single.getOverflow());
+  EXPECT_EQ(2ul, single.getUnderflow());
+  EXPECT_EQ(4ul, single.getN());
+
+  histogram_t batch(0.0, 10.0, BINS);
+  batch.add(values);
+  EXPECT_EQ(single.getCounts(), batch.getCounts());
+}
+
+TEST(Test_cslibs_math, testHistogram) {
+  testHistogram<double>();
+  testHistogram<float>();
+}
+
+TEST(Test_cslibs_math, testHistogramLimits) {
+  testHistogramLimits<double>(1e300);
+  testHistogramLimits<float>(std::numeric_limits<float>::max());
+}
+
+TEST(Test_cslibs_math, testQuantileSketch) {
+  using sketch_t = cslibs_math::statistics::QuantileSketch<double>;
+  cslibs_math::random::Normal<double, 1> rng(0.0, 1.0);
+  std::vector<double> values(NUM_SAMPLES);
+  for (auto &v : values) v = rng.get();
+
+  sketch_t sketch(100);
+  std::vector<sketch_t> parts(4, sketch_t(100));
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) {
+    sketch.add(values[i]);
+    parts[i % parts.size()].add(values[i]);
+  }
+  sketch_t merged(100);
+  for (const auto &p : parts) merged.merge(p);
+
+  /// memory is bounded by the compression
+  EXPECT_LE(sketch.getCentroids().size(), 100ul);
+  EXPECT_LE(merged.getCentroids().size(), 100ul);
+  EXPECT_EQ(double(NUM_SAMPLES), sketch.getWeight());
+  EXPECT_EQ(double(NUM_SAMPLES), merged.getWeight());
+
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(values.front(), sketch.getQuantile(0.0));
+  EXPECT_EQ(values.back(), sketch.getQuantile(1.0));
+  for (const double q : {0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999}) {
+    const double exact = values[std::size_t(q * NUM_SAMPLES)];
+    /// rank error, tighter in the tails
+    const double eps = 0.01 * std::sqrt(q * (1.0 - q)) + 1e-4;
+    const auto rank = [&values](const double v) {
+      return double(std::lower_bound(values.begin(), values.end(), v) -
+                    values.begin()) /
+             double(NUM_SAMPLES);
+    };
+    EXPECT_NEAR(q, rank(sketch.getQuantile(q)), eps) << exact;
+    EXPECT_NEAR(q, rank(merged.getQuantile(q)), eps) << exact;
+  }
+
+  sketch_t empty;
+  EXPECT_EQ(0.0, empty.getQuantile(0.5));
+
+  /// a single centroid still spans [min, max]
+  const sketch_t single(100, 1.0, 3.0, {sketch_t::Centroid{2.0, 10.0}});
+  EXPECT_EQ(1.0, single.getQuantile(0.0));
+  EXPECT_EQ(2.0, single.getQuantile(0.5));
+  EXPECT_EQ(3.0, single.getQuantile(1.0));
+  sketch.reset();
+  EXPECT_EQ(0.0, sketch.getWeight());
+  EXPECT_TRUE(sketch.getCentroids().empty());
+}
+
+TEST(Test_cslibs_math, testHistogramSerialization) {
+  using histogram_t = cslibs_math::statistics::Histogram<double>;
+  using sketch_t = cslibs_math::statistics::QuantileSketch<double>;
+  cslibs_math::random::Uniform<double, 1> rng(-2.0, 12.0);
+  histogram_t h(0.0, 10.0, BINS);
+  sketch_t s;
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) {
+    const double v = rng.get();
+    h.add(v);
+    s.add(v);
+  }
+
+  // yaml
+  const histogram_t h_yaml = YAML::Node(h).as<histogram_t>();
+  EXPECT_EQ(h.getCounts(), h_yaml.getCounts());
+  EXPECT_EQ(h.getN(), h_yaml.getN());
+  EXPECT_EQ(h.getMin(), h_yaml.getMin());
+  EXPECT_EQ(h.getMax(), h_yaml.getMax());
+  const sketch_t s_yaml = YAML::Node(s).as<sketch_t>();
+  EXPECT_EQ(s.getCentroids().size(), s_yaml.getCentroids().size());
+  EXPECT_NEAR(s.getWeight(), s_yaml.getWeight(), 1e-6);
+  EXPECT_NEAR(s.getQuantile(0.9), s_yaml.getQuantile(0.9), 1e-6);
+
+  // binary
+  const std::string path = testing::TempDir() + "test_histogram.bin";
+  {
+    std::ofstream out(path, std::ios::binary);
+    cslibs_math::serialization::histogram::binary<double>::write(h, out);
+    cslibs_math::serialization::quantile_sketch::binary<double>::write(s, out);
+  }
+  histogram_t h_binary;
+  sketch_t s_binary;
+  {
+    std::ifstream in(path, std::ios::binary);
+    cslibs_math::serialization::histogram::binary<double>::read(in, h_binary);
+    cslibs_math::serialization::quantile_sketch::binary<double>::read(
+        in, s_binary);
+  }
+  std::remove(path.c_str());
+  EXPECT_EQ(h.getCounts(), h_binary.getCounts());
+  EXPECT_EQ(s.getMin(), s_binary.getMin());
+  EXPECT_EQ(s.getMax(), s_binary.getMax());
+  EXPECT_EQ(s.getQuantile(0.5), s_binary.getQuantile(0.5));
+
+  /// profiles of several runs aggregate after loading
+  h_binary += h_yaml;
+  s_binary += s_yaml;
+  EXPECT_EQ(2 * h.getN(), h_binary.getN());
+  EXPECT_NEAR(2 * s.getWeight(), s_binary.getWeight(), 1e-6);
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
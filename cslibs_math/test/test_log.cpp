@@ -2,6 +2,7 @@
 
 #include <cslibs_math/approx/log.hpp>
 #include <cslibs_math/random/random.hpp>
+#include <vector>
 
 using Log2d =
     cslibs_math::approx::Log<double,
@@ -215,6 +216,183 @@ TEST(Test_cslibs_math, testOperationLogToValueSubtraction) {
       0.7, true);
 }
 
+namespace impl {
+template <typename T, cslibs_math::approx::ExpAccuracy Accuracy>
+void testFastLog(const double bound) {
+  using fast_log_t = cslibs_math::approx::detail::FastLog<T, Accuracy>;
+  /// absolute error, relative for |log| > 1 where T cannot do better
+  auto error = [](const T v) {
+    const double expected = std::log(double(v));
+    return std::abs(fast_log_t::eval(v) - expected) /
+           std::max(1.0, std::abs(expected));
+  };
+
+  rng_d_t rng{-80.0, 80.0};
+  double max_error = 0.0;
+  for (std::size_t i = 0; i < REPETITIONS; ++i)
+    max_error = std::max(max_error, error(T(std::exp(rng.get()))));
+  /// powers of two and the boundaries of the mantissa, denormals are
+  /// flushed to zero with -ffast-math
+  for (const double v : {1.0, 0.5, 1024.0, M_SQRT2, 1.0 / M_SQRT2,
+                         double(std::numeric_limits<T>::min())})
+    max_error = std::max(max_error, error(T(v)));
+  EXPECT_LT(max_error, bound);
+  EXPECT_LT(fast_log_t::eval(T(0)), std::numeric_limits<T>::lowest());
+}
+}  // namespace impl
+
+TEST(Test_cslibs_math, testFastLog) {
+  using cslibs_math::approx::ExpAccuracy;
+  impl::testFastLog<float, ExpAccuracy::Coarse>(1e-4);
+  impl::testFastLog<float, ExpAccuracy::Fine>(2e-6);
+  impl::testFastLog<float, ExpAccuracy::Full>(2e-6);
+  impl::testFastLog<double, ExpAccuracy::Coarse>(1e-4);
+  impl::testFastLog<double, ExpAccuracy::Fine>(1e-7);
+  impl::testFastLog<double, ExpAccuracy::Full>(1e-13);
+}
+
+TEST(Test_cslibs_math, testFastBase) {
+  using cslibs_math::approx::ExpAccuracy;
+  using FastLog2d =
+      cslibs_math::approx::detail::FastBase2<double, ExpAccuracy::Fine>;
+  using FastLnd =
+      cslibs_math::approx::detail::FastBaseE<double, ExpAccuracy::Coarse>;
+  using log_fine_t = cslibs_math::approx::Log<double, FastLog2d>;
+  using log_coarse_t = cslibs_math::approx::Log<double, FastLnd>;
+
+  /// the approximations are bounded in the relative error of the values
+  rng_d_t rng{1e-4, 10000000.0};
+  for (std::size_t i = 0; i < REPETITIONS; ++i) {
+    const double va = rng.get();
+    const double vb = rng.get();
+    EXPECT_NEAR(1.0, log_fine_t(va).exp() / va, 1e-6);
+    EXPECT_NEAR(1.0, (log_fine_t(va) * log_fine_t(vb)).exp() / (va * vb),
+                1e-6);
+    EXPECT_NEAR(1.0, (log_fine_t(va) / vb).exp() / (va / vb), 1e-6);
+    EXPECT_NEAR(1.0, (log_fine_t(va) + log_fine_t(vb)).exp() / (va + vb),
+                1e-6);
+    EXPECT_NEAR(1.0, (log_coarse_t(va) + log_coarse_t(vb)).exp() / (va + vb),
+                1e-3);
+    EXPECT_NEAR(std::log2(va + vb),
+                (log_fine_t(va) + log_fine_t(vb)).value(), 1e-6);
+  }
+}
+
+TEST(Test_cslibs_math, testLogAdditionRange) {
+  /// exp of the difference must not overflow, the result is the larger one
+  const auto a = Lnd(1e-300);
+  const auto b = Lnd(1e300);
+  EXPECT_NEAR(std::log(1e300), (a + b).value(), 1e-9);
+  EXPECT_NEAR(std::log(1e300), (b + a).value(), 1e-9);
+  auto c = a;
+  c += b;
+  EXPECT_NEAR(std::log(1e300), c.value(), 1e-9);
+}
+
+TEST(Test_cslibs_math, testLogSumExp) {
+  using cslibs_math::approx::ExpAccuracy;
+  rng_d_t rng{-1000.0, 10.0};
+  for (const std::size_t n : {1ul, 3ul, 17ul, 1000ul}) {
+    std::vector<double> values(n);
+    for (double &v : values) v = rng.get();
+    const double max = *std::max_element(values.begin(), values.end());
+    double sum = 0.0;
+    for (const double v : values) sum += std::exp(v - max);
+    const double expected = max + std::log(sum);
+
+    EXPECT_NEAR(expected, cslibs_math::approx::logSumExp(values.data(), n),
+                1e-12);
+    EXPECT_NEAR(expected,
+                cslibs_math::approx::logSumExp<ExpAccuracy::Coarse>(
+                    values.data(), n),
+                1e-4);
+
+    std::vector<float> values_f(values.begin(), values.end());
+    EXPECT_NEAR(expected,
+                cslibs_math::approx::logSumExp<ExpAccuracy::Fine>(
+                    values_f.data(), n),
+                1e-4 * std::abs(expected));
+  }
+  const double empty = cslibs_math::approx::logSumExp(
+      static_cast<const double *>(nullptr), 0);
+  EXPECT_LT(empty, std::numeric_limits<double>::lowest());
+}
+
+TEST(Test_cslibs_math, testParallelLogSumExp) {
+  rng_d_t rng{-50.0, 0.0};
+  const std::size_t n = 100003;
+  std::vector<double> values(n);
+  for (double &v : values) v = rng.get();
+  const double expected = cslibs_math::approx::logSumExp(values.data(), n);
+
+  /// the chunks are combined in order, more threads only regroup the sum
+  for (const std::size_t threads : {1ul, 2ul, 4ul, 7ul}) {
+    EXPECT_NEAR(expected,
+                cslibs_math::approx::logSumExp(values.data(), n, threads),
+                1e-12);
+  }
+  EXPECT_EQ(expected, cslibs_math::approx::logSumExp(values.data(), n, 1));
+
+  std::vector<double> empty(n, -std::numeric_limits<double>::infinity());
+  const double all_empty =
+      cslibs_math::approx::logSumExp(empty.data(), n, 4);
+  EXPECT_LT(all_empty, std::numeric_limits<double>::lowest());
+}
+
+TEST(Test_cslibs_math, testNormalizeLogWeights) {
+  using cslibs_math::approx::ExpAccuracy;
+  rng_d_t rng{-800.0, 10.0};
+  for (const std::size_t n : {1ul, 5ul, 1000ul, 50000ul}) {
+    std::vector<double> log_weights(n);
+    for (double &v : log_weights) v = rng.get();
+    const double expected =
+        cslibs_math::approx::logSumExp(log_weights.data(), n);
+
+    /// linear weights, serial and parallel
+    for (const std::size_t threads : {1ul, 4ul}) {
+      std::vector<double> weights(n);
+      EXPECT_NEAR(expected,
+                  cslibs_math::approx::normalizeLogWeights(
+                      log_weights.data(), weights.data(), n, threads),
+                  1e-12);
+      double sum = 0.0;
+      for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(std::exp(log_weights[i] - expected), weights[i], 1e-12);
+        sum += weights[i];
+      }
+      EXPECT_NEAR(1.0, sum, 1e-12);
+    }
+
+    /// in place, the normalized weights have a log-sum-exp of 0
+    std::vector<double> normalized = log_weights;
+    EXPECT_NEAR(expected,
+                cslibs_math::approx::normalizeLogWeights(normalized.data(), n),
+                1e-12);
+    EXPECT_NEAR(0.0, cslibs_math::approx::logSumExp(normalized.data(), n),
+                1e-12);
+    std::vector<double> parallel = log_weights;
+    cslibs_math::approx::normalizeLogWeights(parallel.data(), n, 4);
+    for (std::size_t i = 0; i < n; ++i)
+      EXPECT_NEAR(normalized[i], parallel[i], 1e-12);
+
+    std::vector<float> log_weights_f(log_weights.begin(), log_weights.end());
+    std::vector<float> weights_f(n);
+    cslibs_math::approx::normalizeLogWeights<ExpAccuracy::Coarse>(
+        log_weights_f.data(), weights_f.data(), n);
+    double sum = 0.0;
+    for (const float w : weights_f) sum += w;
+    EXPECT_NEAR(1.0, sum, 1e-3);
+  }
+
+  /// all weights -inf stay untouched
+  std::vector<double> empty(3, -std::numeric_limits<double>::infinity());
+  std::vector<double> weights(3, 1.0);
+  cslibs_math::approx::normalizeLogWeights(empty.data(), weights.data(), 3);
+  EXPECT_EQ(0.0, weights[0]);
+  cslibs_math::approx::normalizeLogWeights(empty.data(), 3);
+  EXPECT_LT(empty[0], std::numeric_limits<double>::lowest());
+}
+
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/common/log_odds.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using cslibs_math::common::LogOdds;
+using cslibs_math::common::LogOddsClamp;
+using cslibs_math::common::LogOddsFixed;
+using cslibs_math::common::LogOddsScale;
+
+using saturate_t = LogOddsFixed<>;
+using clamp_t = LogOddsFixed<std::int16_t, LogOddsScale<11>, LogOddsClamp>;
+
+const std::size_t SIZE = 1000;
+
+namespace impl {
+/// maximum absolute error of the table over all cells
+template <typename LogOddsFixedT>
+float maxProbabilityError(const LogOddsFixedT &model) {
+  float error = 0.0f;
+  for (int c = LogOddsFixedT::min; c <= LogOddsFixedT::max; ++c) {
+    const auto cell = static_cast<typename LogOddsFixedT::cell_t>(c);
+    const float expected = static_cast<float>(
+        LogOdds<double>::from(LogOddsFixedT::logOdds(cell)));
+    error = std::max(error, std::abs(model.probability(cell) - expected));
+  }
+  return error;
+}
+}  // namespace impl
+
+TEST(Test_cslibs_math, testLogOddsFixedQuantize) {
+  for (float l = -15.0f; l <= 15.0f; l += 0.01f) {
+    const auto cell = saturate_t::quantize(l);
+    EXPECT_NEAR(saturate_t::logOdds(cell), l, 0.5f / saturate_t::scale);
+  }
+  EXPECT_EQ(saturate_t::min, std::numeric_limits<std::int16_t>::min());
+  EXPECT_EQ(saturate_t::max, std::numeric_limits<std::int16_t>::max());
+  EXPECT_EQ(saturate_t::quantize(100.0f), saturate_t::max);
+  EXPECT_EQ(saturate_t::quantize(-100.0f), saturate_t::min);
+
+  EXPECT_EQ(clamp_t::min, -2 * 2048);
+  EXPECT_EQ(clamp_t::max, 7 * 1024);
+  EXPECT_EQ(clamp_t::quantize(-3.0f), clamp_t::min);
+  EXPECT_EQ(clamp_t::quantize(4.0f), clamp_t::max);
+  EXPECT_EQ(clamp_t::quantize(0.0f), 0);
+
+  EXPECT_EQ(clamp_t::fromProbability(0.5f), 0);
+  EXPECT_NEAR(clamp_t::logOdds(clamp_t::fromProbability(0.7f)),
+              LogOdds<float>::to(0.7f), 0.5f / clamp_t::scale);
+}
+
+TEST(Test_cslibs_math, testLogOddsFixedSaturation) {
+  const clamp_t model(0.7f, 0.4f);
+  EXPECT_GT(model.hit(), 0);
+  EXPECT_LT(model.miss(), 0);
+
+  std::int16_t cell = 0;
+  for (std::size_t i = 0; i < 100; ++i)
+    cell = clamp_t::update(cell, model.hit());
+  EXPECT_EQ(cell, clamp_t::max);
+  cell = clamp_t::update(cell, model.miss());
+  EXPECT_EQ(cell, clamp_t::max + model.miss());
+  for (std::size_t i = 0; i < 100; ++i)
+    cell = clamp_t::update(cell, model.miss());
+  EXPECT_EQ(cell, clamp_t::min);
+
+  /// no wrap around at the limits of the integer type
+  const saturate_t saturate(0.9f, 0.1f);
+  EXPECT_EQ(saturate_t::update(saturate_t::max, saturate.hit()),
+            saturate_t::max);
+  EXPECT_EQ(saturate_t::update(saturate_t::min, saturate.miss()),
+            saturate_t::min);
+}
+
+TEST(Test_cslibs_math, testLogOddsFixedBatch) {
+  cslibs_math::random::Uniform<double, 1> rng(-3.0, 4.0, 42);
+  const clamp_t model(0.7f, 0.4f);
+  std::vector<std::int16_t> cells(SIZE);
+  for (auto &c : cells) c = clamp_t::quantize(static_cast<float>(rng.get()));
+
+  for (const std::int16_t delta : {model.hit(), model.miss()}) {
+    std::vector<std::int16_t> expected = cells;
+    for (auto &c : expected) c = clamp_t::update(c, delta);
+    std::vector<std::int16_t> batch = cells;
+    clamp_t::update(batch.data(), batch.size(), delta);
+    EXPECT_EQ(batch, expected);
+  }
+
+  std::vector<std::uint32_t> indices;
+  for (std::uint32_t i = 3; i < SIZE; i += 7) indices.emplace_back(i);
+  std::vector<std::int16_t> expected = cells;
+  for (const auto i : indices) expected[i] = clamp_t::update(expected[i], 100);
+  std::vector<std::int16_t> indexed = cells;
+  clamp_t::update(indexed.data(), indices.data(), indices.size(), 100);
+  EXPECT_EQ(indexed, expected);
+}
+
+TEST(Test_cslibs_math, testLogOddsFixedProbability) {
+  const saturate_t saturate(0.7f, 0.4f);
+  EXPECT_LE(saturate_t::table_size, 1025u);
+  EXPECT_LT(impl::maxProbabilityError(saturate), 1.2e-5f);
+
+  const clamp_t clamp(0.7f, 0.4f);
+  EXPECT_LT(impl::maxProbabilityError(clamp), 1e-6f);
+  EXPECT_NEAR(clamp.probability(clamp_t::min), 0.119203f, 1e-6f);
+  EXPECT_NEAR(clamp.probability(clamp_t::max), 0.970688f, 1e-6f);
+  EXPECT_FLOAT_EQ(clamp.probability(0), 0.5f);
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
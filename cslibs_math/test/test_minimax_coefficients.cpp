@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cslibs_math/approx/minimax_coefficients.hpp>
+#include <limits>
+
+using cslibs_math::approx::ExpAccuracy;
+using namespace cslibs_math::approx::detail;
+const std::size_t SAMPLES = 100001;
+
+namespace impl {
+/**
+ * @brief Maximum relative error of the polynomial with the tabulated
+ *        coefficients, evaluated in long double, against the reference f on
+ *        [min, max].
+ */
+template <typename Polynomial, typename Function>
+long double maxRelativeError(const Function &f, const long double min,
+                             const long double max) {
+  long double error = 0.0L;
+  for (std::size_t i = 0; i < SAMPLES; ++i) {
+    const long double x =
+        min + (max - min) * static_cast<long double>(i) / (SAMPLES - 1);
+    long double p = Polynomial::coefficients[Polynomial::degree];
+    for (std::size_t k = Polynomial::degree; k > 0; --k)
+      p = p * x + Polynomial::coefficients[k - 1];
+    const long double expected = f(x);
+    error = std::max(error, std::abs(p / expected - 1.0L));
+  }
+  return error;
+}
+
+/// the bound holds up to the rounding of the long double evaluation and is
+/// not loose, it is rounded up to two digits only
+template <typename Polynomial, typename Function>
+void testBound(const Function &f, const long double min,
+               const long double max) {
+  const long double error = maxRelativeError<Polynomial>(f, min, max);
+  EXPECT_LE(error, Polynomial::error +
+                       4.0L * std::numeric_limits<long double>::epsilon());
+  EXPECT_GT(error, 0.5L * Polynomial::error);
+}
+
+template <template <typename, ExpAccuracy> class Polynomial, typename T>
+void testTiers() {
+  EXPECT_LT((Polynomial<T, ExpAccuracy::Fine>::error),
+            (Polynomial<T, ExpAccuracy::Coarse>::error));
+  EXPECT_LE((Polynomial<T, ExpAccuracy::Full>::error),
+            (Polynomial<T, ExpAccuracy::Fine>::error));
+  EXPECT_LE((Polynomial<T, ExpAccuracy::Full>::error),
+            std::numeric_limits<T>::epsilon());
+}
+
+const long double LN2_2 = 0.5L * std::log(2.0L);
+const long double TAN_PI_8 = std::sqrt(2.0L) - 1.0L;
+
+long double exp(const long double r) { return std::exp(r); }
+
+/// atanh(s) / s with z = s^2
+long double atanhRatio(const long double z) {
+  const long double s = std::sqrt(z);
+  return z > 0.0L ? std::atanh(s) / s : 1.0L;
+}
+
+/// atan(u) / u with z = u^2
+long double atanRatio(const long double z) {
+  const long double u = std::sqrt(z);
+  return z > 0.0L ? std::atan(u) / u : 1.0L;
+}
+
+template <typename T, ExpAccuracy Accuracy>
+void testPolynomials() {
+  testBound<ExpPolynomial<T, Accuracy>>(exp, -LN2_2, LN2_2);
+  /// |s| <= (sqrt(2) - 1) / (sqrt(2) + 1) = tan(pi / 8)^2
+  testBound<LogPolynomial<T, Accuracy>>(atanhRatio, 0.0L,
+                                        std::pow(TAN_PI_8, 4));
+  testBound<AtanPolynomial<T, Accuracy>>(atanRatio, 0.0L,
+                                         TAN_PI_8 * TAN_PI_8);
+}
+}  // namespace impl
+
+TEST(Test_cslibs_math, testMinimaxBounds) {
+  impl::testPolynomials<float, ExpAccuracy::Coarse>();
+  impl::testPolynomials<float, ExpAccuracy::Fine>();
+  impl::testPolynomials<float, ExpAccuracy::Full>();
+  impl::testPolynomials<double, ExpAccuracy::Coarse>();
+  impl::testPolynomials<double, ExpAccuracy::Fine>();
+  impl::testPolynomials<double, ExpAccuracy::Full>();
+}
+
+TEST(Test_cslibs_math, testMinimaxTiers) {
+  impl::testTiers<ExpPolynomial, float>();
+  impl::testTiers<ExpPolynomial, double>();
+  impl::testTiers<LogPolynomial, float>();
+  impl::testTiers<LogPolynomial, double>();
+  impl::testTiers<AtanPolynomial, float>();
+  impl::testTiers<AtanPolynomial, double>();
+}
+
+TEST(Test_cslibs_math, testMinimaxConstexpr) {
+  /// the tables are usable at compile time, no runtime setup
+  static_assert(ExpPolynomial<double, ExpAccuracy::Full>::degree == 11,
+                "unexpected degree");
+  static_assert(LogPolynomial<float, ExpAccuracy::Coarse>::coefficients[0] >
+                    0.99f,
+                "unexpected coefficient");
+  static_assert(AtanPolynomial<double, ExpAccuracy::Fine>::error < 1e-7,
+                "unexpected bound");
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
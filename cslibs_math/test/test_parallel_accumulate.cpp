@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/angular_mean.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <cslibs_math/statistics/parallel_accumulate.hpp>
+#include <cslibs_math/statistics/stable_distribution.hpp>
+#include <cslibs_math/statistics/weighted_distribution.hpp>
+
+const std::size_t NUM_SAMPLES = 100000;
+
+using sample_t = Eigen::Vector3d;
+using samples_t = std::vector<sample_t, Eigen::aligned_allocator<sample_t>>;
+
+samples_t randomSamples(const std::size_t n) {
+  cslibs_math::random::Uniform<double, 3> rng(sample_t::Constant(-10.0),
+                                              sample_t::Constant(10.0));
+  samples_t samples(n);
+  for (auto &p : samples) p = rng.get();
+  return samples;
+}
+
+template <typename distribution_t>
+void expectNear(const distribution_t &a, const distribution_t &b) {
+  EXPECT_EQ(a.getN(), b.getN());
+  EXPECT_NEAR(0.0, (a.getMean() - b.getMean()).cwiseAbs().maxCoeff(), 1e-9);
+  EXPECT_NEAR(
+      0.0, (a.getCovariance() - b.getCovariance()).cwiseAbs().maxCoeff(),
+      1e-8);
+}
+
+template <typename distribution_t>
+void testDistribution() {
+  using namespace cslibs_math::statistics;
+  const samples_t samples = randomSamples(NUM_SAMPLES);
+
+  distribution_t sequential;
+  for (const auto &p : samples) sequential.add(p);
+
+  for (const std::size_t threads : {1ul, 2ul, 3ul, 4ul, 7ul, 0ul}) {
+    const distribution_t d =
+        parallelAccumulate<distribution_t>(samples, threads);
+    expectNear(sequential, d);
+
+    /// fixed thread count, bitwise identical results
+    const distribution_t e =
+        parallelAccumulate<distribution_t>(samples, threads);
+    EXPECT_TRUE(d.getMean() == e.getMean());
+    EXPECT_TRUE(d.getCovariance() == e.getCovariance());
+  }
+}
+
+TEST(Test_cslibs_math, testParallelAccumulateDistribution) {
+  using namespace cslibs_math::statistics;
+  testDistribution<Distribution<double, 3>>();
+  testDistribution<StableDistribution<double, 3>>();
+}
+
+TEST(Test_cslibs_math, testParallelAccumulateSmallRanges) {
+  using namespace cslibs_math::statistics;
+  using distribution_t = Distribution<double, 3>;
+
+  const samples_t empty;
+  EXPECT_EQ(0ul, parallelAccumulate<distribution_t>(empty, 4).getN());
+
+  /// more threads than samples
+  const samples_t samples = randomSamples(5);
+  distribution_t sequential;
+  for (const auto &p : samples) sequential.add(p);
+  expectNear(sequential, parallelAccumulate<distribution_t>(
+                             samples.begin(), samples.end(), 16));
+}
+
+TEST(Test_cslibs_math, testParallelAccumulateCustomAdd) {
+  using namespace cslibs_math::statistics;
+  using distribution_t = WeightedDistribution<double, 3>;
+  using weighted_sample_t = std::pair<sample_t, double>;
+
+  const samples_t samples = randomSamples(NUM_SAMPLES);
+  cslibs_math::random::Uniform<double, 1> rng(0.1, 1.0);
+  std::vector<weighted_sample_t, Eigen::aligned_allocator<weighted_sample_t>>
+      weighted;
+  distribution_t sequential;
+  for (const auto &p : samples) {
+    weighted.emplace_back(p, rng.get());
+    sequential.add(weighted.back().first, weighted.back().second);
+  }
+
+  const distribution_t d = parallelAccumulate<distribution_t>(
+      weighted, 4, [](distribution_t &d, const weighted_sample_t &s) {
+        d.add(s.first, s.second);
+      });
+  EXPECT_NEAR(sequential.getWeight(), d.getWeight(), 1e-6);
+  EXPECT_NEAR(0.0, (sequential.getMean() - d.getMean()).cwiseAbs().maxCoeff(),
+              1e-9);
+  EXPECT_NEAR(
+      0.0,
+      (sequential.getCovariance() - d.getCovariance()).cwiseAbs().maxCoeff(),
+      1e-8);
+
+  std::vector<double> angles(NUM_SAMPLES);
+  cslibs_math::random::Uniform<double, 1> rng_angle(-1.0, 2.0);
+  AngularMean<double> angular;
+  for (auto &a : angles) {
+    a = rng_angle.get();
+    angular.add(a);
+  }
+  EXPECT_NEAR(angular.getMean(),
+              parallelAccumulate<AngularMean<double>>(angles, 4).getMean(),
+              1e-9);
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
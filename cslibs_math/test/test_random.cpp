@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <cslibs_math/random/random.hpp>
+#include <thread>
+#include <vector>
 
 TEST(Test_cslibs_math, testNorma1D) {
   const std::size_t size = 100000;
@@ -27,6 +29,99 @@ TEST(Test_cslibs_math, testNorma1D) {
   for (std::size_t i = 0; i < size; ++i) EXPECT_NE(seq_1[i], seq_4[i]);
 }
 
+using cslibs_math::random::Philox4x32;
+
+TEST(Test_cslibs_math, testPhilox4x32KnownAnswers) {
+  /// test vectors of the Random123 reference implementation
+  using counter_t = Philox4x32::counter_t;
+  EXPECT_EQ(Philox4x32::block({{0u, 0u, 0u, 0u}}, {{0u, 0u}}),
+            (counter_t{{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}}));
+  EXPECT_EQ(Philox4x32::block(
+                {{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}},
+                {{0xffffffffu, 0xffffffffu}}),
+            (counter_t{{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}}));
+  EXPECT_EQ(Philox4x32::block(
+                {{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}},
+                {{0xa4093822u, 0x299f31d0u}}),
+            (counter_t{{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}}));
+
+  Philox4x32 rng;
+  EXPECT_EQ(rng(), 0xe169c58d6627e8d5ull);
+  EXPECT_EQ(rng(), 0x9b00dbd8bc57ac4cull);
+}
+
+TEST(Test_cslibs_math, testPhilox4x32Streams) {
+  const std::size_t size = 1001;
+  Philox4x32 rng(42);
+  std::vector<Philox4x32::result_type> sequence(size);
+  for (auto &r : sequence) r = rng();
+
+  for (const std::size_t n : {0ul, 1ul, 2ul, 3ul, 500ul}) {
+    Philox4x32 skipped(42);
+    skipped.discard(n);
+    EXPECT_EQ(skipped(), sequence[n]);
+  }
+
+  Philox4x32 same(42);
+  rng.seed(42);
+  for (std::size_t i = 0; i < size; ++i) EXPECT_EQ(same(), rng());
+
+  /// streams of a seed and seeds of a stream differ
+  Philox4x32 stream = Philox4x32(42).split(1);
+  Philox4x32 other_seed(43);
+  EXPECT_EQ(stream.stream(), 1u);
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto r = stream();
+    EXPECT_NE(r, sequence[i]);
+    EXPECT_NE(other_seed(), sequence[i]);
+    EXPECT_NE(r, rng());
+  }
+  Philox4x32 copy(42, 1);
+  Philox4x32 split = Philox4x32(42).split(1);
+  for (std::size_t i = 0; i < size; ++i) EXPECT_EQ(copy(), split());
+}
+
+TEST(Test_cslibs_math, testPhilox4x32Parallel) {
+  /// one stream per particle, the samples do not depend on the threads
+  const std::size_t particles = 1000;
+  const std::size_t samples = 10;
+  auto sample = [](std::vector<double> &result, const std::size_t threads) {
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&result, t, threads]() {
+        for (std::size_t p = t; p < particles; p += threads) {
+          cslibs_math::random::Normal<double, 1, Philox4x32> rng(
+              0.0, 1.0, Philox4x32(42, p));
+          for (std::size_t i = 0; i < samples; ++i)
+            result[p * samples + i] = rng.get();
+        }
+      });
+    }
+    for (auto &w : workers) w.join();
+  };
+  std::vector<double> single(particles * samples);
+  std::vector<double> multiple(particles * samples);
+  sample(single, 1);
+  sample(multiple, 4);
+  EXPECT_EQ(single, multiple);
+
+  double mean = 0.0;
+  for (const double s : single) mean += s;
+  mean /= static_cast<double>(single.size());
+  EXPECT_NEAR(mean, 0.0, 0.05);
+
+  cslibs_math::random::Uniform<double, 1, Philox4x32> uniform(
+      0.0, 1.0, Philox4x32(42));
+  double sum = 0.0;
+  for (std::size_t i = 0; i < 10000; ++i) {
+    const double u = uniform.get();
+    EXPECT_GE(u, 0.0);
+    EXPECT_LT(u, 1.0);
+    sum += u;
+  }
+  EXPECT_NEAR(sum / 10000.0, 0.5, 0.01);
+}
+
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/linear/symmetric_eigen.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/limit_eigen_values.hpp>
+
+const std::size_t REPETITIONS = 10000;
+
+template <typename T, std::size_t Dim>
+Eigen::Matrix<T, Dim, Dim> randomCovariance(
+    cslibs_math::random::Uniform<T, 1> &rng) {
+  Eigen::Matrix<T, Dim, Dim> a;
+  for (std::size_t i = 0; i < Dim; ++i)
+    for (std::size_t j = 0; j < Dim; ++j) a(i, j) = rng.get();
+  return a * a.transpose();
+}
+
+template <typename T, std::size_t Dim>
+void testDecomposition(const Eigen::Matrix<T, Dim, Dim> &m, const T eps) {
+  using solver_t = cslibs_math::linear::SymmetricEigen<T, Dim>;
+  typename solver_t::eigen_values_t values;
+  typename solver_t::eigen_vectors_t vectors;
+  solver_t::compute(m, values, vectors);
+
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix<T, Dim, Dim>> reference(m);
+  const T scale = std::max(T(1), m.cwiseAbs().maxCoeff());
+  for (std::size_t i = 0; i < Dim; ++i) {
+    EXPECT_NEAR(reference.eigenvalues()(i), values(i), eps * scale);
+    EXPECT_NEAR(1.0, vectors.col(i).norm(), eps);
+    /// A v = lambda v
+    const Eigen::Matrix<T, Dim, 1> r =
+        m * vectors.col(i) - values(i) * vectors.col(i);
+    EXPECT_NEAR(0.0, r.norm(), eps * scale);
+  }
+  if (Dim > 1) {
+    EXPECT_LE(values(0), values(Dim - 1));
+  }
+  /// reconstruction
+  const Eigen::Matrix<T, Dim, Dim> rec =
+      vectors * values.asDiagonal() * vectors.transpose();
+  EXPECT_NEAR(0.0, (rec - m).cwiseAbs().maxCoeff(), eps * scale);
+
+  typename solver_t::eigen_values_t values_only;
+  solver_t::compute(m, values_only);
+  EXPECT_NEAR(0.0, (values_only - values).cwiseAbs().maxCoeff(),
+              std::sqrt(eps) * scale);
+}
+
+template <typename T, std::size_t Dim>
+void testRandom(const T eps) {
+  cslibs_math::random::Uniform<T, 1> rng(-10.0, 10.0);
+  for (std::size_t i = 0; i < REPETITIONS; ++i)
+    testDecomposition<T, Dim>(randomCovariance<T, Dim>(rng), eps);
+}
+
+TEST(Test_cslibs_math, testSymmetricEigen2D) {
+  testRandom<double, 2>(1e-9);
+  testRandom<float, 2>(1e-3f);
+
+  /// degenerated cases
+  testDecomposition<double, 2>(Eigen::Matrix2d::Zero(), 1e-9);
+  testDecomposition<double, 2>(Eigen::Matrix2d::Identity(), 1e-9);
+  testDecomposition<double, 2>(Eigen::Vector2d(1.0, 0.0).asDiagonal(), 1e-9);
+}
+
+TEST(Test_cslibs_math, testSymmetricEigen3D) {
+  testRandom<double, 3>(1e-8);
+  testRandom<float, 3>(5e-3f);
+
+  /// degenerated cases
+  testDecomposition<double, 3>(Eigen::Matrix3d::Zero(), 1e-9);
+  testDecomposition<double, 3>(Eigen::Matrix3d::Identity(), 1e-9);
+  testDecomposition<double, 3>(Eigen::Vector3d(3.0, 1.0, 2.0).asDiagonal(),
+                               1e-9);
+
+  /// planar and linear point sets, i.e. double eigen values
+  const Eigen::Vector3d n = Eigen::Vector3d(1.0, 2.0, 3.0).normalized();
+  const Eigen::Matrix3d plane = Eigen::Matrix3d::Identity() - n * n.transpose();
+  testDecomposition<double, 3>(plane, 1e-9);
+  testDecomposition<double, 3>(n * n.transpose(), 1e-9);
+  testDecomposition<double, 3>(2.0 * Eigen::Matrix3d::Identity() +
+                                   n * n.transpose(),
+                               1e-9);
+}
+
+TEST(Test_cslibs_math, testSymmetricEigen4D) { testRandom<double, 4>(1e-8); }
+
+TEST(Test_cslibs_math, testLimitEigenValues) {
+  using limit_t = cslibs_math::statistics::LimitEigenValues<double, 3, 1>;
+  const Eigen::Vector3d n = Eigen::Vector3d(1.0, -1.0, 0.5).normalized();
+  Eigen::Matrix3d m = 10.0 * n * n.transpose();
+  limit_t::apply(m);
+
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(m);
+  EXPECT_NEAR(1.0, solver.eigenvalues()(0), 1e-9);
+  EXPECT_NEAR(1.0, solver.eigenvalues()(1), 1e-9);
+  EXPECT_NEAR(10.0, solver.eigenvalues()(2), 1e-9);
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/approx/tabulated_function.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <vector>
+
+using cslibs_math::approx::Interpolation;
+const std::size_t SAMPLES = 100003;
+
+/// a table of a constexpr function can be built at compile time
+constexpr double square(const double x) { return x * x; }
+constexpr cslibs_math::approx::TabulatedFunction<double, 5> SQUARES(square,
+                                                                    0.0, 4.0);
+static_assert(SQUARES.table()[0] == 1.0, "sample beyond min");
+static_assert(SQUARES.table()[3] == 4.0, "sample at 2");
+static_assert(SQUARES.step() == 1.0, "step");
+
+template <typename T, std::size_t N, Interpolation I>
+double maxGaussianError(const T sigma) {
+  const cslibs_math::approx::GaussianKernel<T, N, I> kernel(sigma);
+  cslibs_math::random::Uniform<double, 1> rng(-4.0 * sigma, 4.0 * sigma, 42);
+  std::vector<T> distances(SAMPLES);
+  for (T &d : distances) d = static_cast<T>(rng.get());
+
+  std::vector<T> out(SAMPLES);
+  kernel(distances.data(), out.data(), SAMPLES);
+  double error = 0.0;
+  for (std::size_t i = 0; i < SAMPLES; ++i) {
+    const double d = static_cast<double>(distances[i]) / sigma;
+    error = std::max(error, std::abs(out[i] - std::exp(-0.5 * d * d)));
+    /// the batch loop may be vectorized and rounded differently
+    EXPECT_NEAR(out[i], kernel(distances[i]), 1e-6);
+  }
+  return error;
+}
+
+TEST(Test_cslibs_math, testTabulatedFunction) {
+  /// the samples are exact, linear interpolates between them
+  EXPECT_EQ(4.0, SQUARES(2.0));
+  EXPECT_EQ(2.5, SQUARES(1.5));
+  EXPECT_EQ(16.0, SQUARES(4.0));
+  /// clamped to the domain
+  EXPECT_EQ(0.0, SQUARES(-1.0));
+  EXPECT_EQ(16.0, SQUARES(5.0));
+
+  /// Catmull-Rom reproduces quadratic functions
+  const cslibs_math::approx::TabulatedFunction<double, 5, Interpolation::Cubic>
+      cubic(square, 0.0, 4.0);
+  EXPECT_NEAR(2.25, cubic(1.5), 1e-12);
+  EXPECT_NEAR(12.25, cubic(3.5), 1e-12);
+  EXPECT_NEAR(16.0, cubic(4.0), 1e-12);
+
+  std::vector<double> values = {-1.0, 0.5, 3.75};
+  SQUARES(values.data(), values.data(), values.size());
+  EXPECT_EQ(0.0, values[0]);
+  EXPECT_EQ(0.5, values[1]);
+  EXPECT_EQ(14.25, values[2]);
+}
+
+TEST(Test_cslibs_math, testGaussianKernel) {
+  EXPECT_LT((maxGaussianError<double, 64, Interpolation::Linear>(0.5)), 6e-4);
+  EXPECT_LT((maxGaussianError<double, 1024, Interpolation::Linear>(0.5)),
+            2e-6);
+  EXPECT_LT((maxGaussianError<double, 64, Interpolation::Cubic>(0.5)), 5e-5);
+  EXPECT_LT((maxGaussianError<double, 1024, Interpolation::Cubic>(0.5)),
+            5e-9);
+  EXPECT_LT((maxGaussianError<float, 1024, Interpolation::Linear>(2.0f)),
+            3e-6);
+
+  const cslibs_math::approx::GaussianKernel<double> kernel(0.5, 3.0);
+  EXPECT_EQ(1.0, kernel(0.0));
+  EXPECT_EQ(kernel(0.3), kernel(-0.3));
+  EXPECT_NEAR(std::exp(-4.5), kernel(10.0), 1e-12);
+  EXPECT_EQ(1.5, kernel.table().max());
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/approx/trigonometric.hpp>
+#include <cslibs_math/common/angle.hpp>
+#include <cslibs_math/common/fast_angle.hpp>
+#include <cslibs_math/random/random.hpp>
+#include <vector>
+
+const std::size_t SAMPLES = 100003;
+
+template <typename T>
+std::vector<T> uniform(const double range, const unsigned int seed) {
+  cslibs_math::random::Uniform<double, 1> rng(-range, range, seed);
+  std::vector<T> values(SAMPLES);
+  for (T &v : values) v = static_cast<T>(rng.get());
+  return values;
+}
+
+template <typename T>
+void testSinCos(const double range, const double bound) {
+  std::vector<T> angles = uniform<T>(range, 42);
+  /// the quadrant boundaries
+  for (int q = -4; q <= 4; ++q) angles[q + 4] = static_cast<T>(q * M_PI_2);
+
+  std::vector<T> sin(SAMPLES);
+  std::vector<T> cos(SAMPLES);
+  cslibs_math::approx::sincos(angles.data(), sin.data(), cos.data(), SAMPLES);
+  double max_error = 0.0;
+  for (std::size_t i = 0; i < SAMPLES; ++i) {
+    const double a = static_cast<double>(angles[i]);
+    max_error = std::max(max_error, std::abs(sin[i] - std::sin(a)));
+    max_error = std::max(max_error, std::abs(cos[i] - std::cos(a)));
+    /// the packet and the scalar kernel are the same
+    T s;
+    T c;
+    cslibs_math::approx::sincos(angles[i], s, c);
+    EXPECT_EQ(sin[i], s);
+    EXPECT_EQ(cos[i], c);
+  }
+  EXPECT_LT(max_error, bound);
+}
+
+template <typename T>
+void testAtan2(const double bound) {
+  std::vector<T> y = uniform<T>(10.0, 42);
+  std::vector<T> x = uniform<T>(10.0, 43);
+  /// axes, diagonals and the origin
+  const T axes[][2] = {{0, 0}, {0, 1},  {1, 0},  {0, -1}, {-1, 0},
+                       {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+  for (std::size_t i = 0; i < 9; ++i) {
+    y[i] = axes[i][0];
+    x[i] = axes[i][1];
+  }
+
+  std::vector<T> out(SAMPLES);
+  cslibs_math::approx::atan2(y.data(), x.data(), out.data(), SAMPLES);
+  double max_error = 0.0;
+  for (std::size_t i = 0; i < SAMPLES; ++i) {
+    const double expected = std::atan2(static_cast<double>(y[i]),
+                                       static_cast<double>(x[i]));
+    max_error = std::max(max_error, std::abs(out[i] - expected));
+    /// -ffast-math may round the scalar kernel differently
+    EXPECT_NEAR(out[i], cslibs_math::approx::atan2(y[i], x[i]), bound);
+  }
+  EXPECT_LT(max_error, bound);
+}
+
+template <typename T>
+void testHypot(const double bound) {
+  const std::vector<T> x = uniform<T>(1e3, 42);
+  const std::vector<T> y = uniform<T>(1e-3, 43);
+
+  std::vector<T> out(SAMPLES);
+  cslibs_math::approx::hypot(x.data(), y.data(), out.data(), SAMPLES);
+  double max_error = 0.0;
+  for (std::size_t i = 0; i < SAMPLES; ++i) {
+    const double expected =
+        std::hypot(static_cast<double>(x[i]), static_cast<double>(y[i]));
+    max_error = std::max(max_error, std::abs(out[i] / expected - 1.0));
+    EXPECT_NEAR(out[i], cslibs_math::approx::hypot(x[i], y[i]),
+                bound * expected);
+  }
+  EXPECT_LT(max_error, bound);
+  EXPECT_EQ(T(0), cslibs_math::approx::hypot(T(0), T(0)));
+}
+
+TEST(Test_cslibs_math, testSinCos) {
+  testSinCos<float>(M_PI, 1e-7);
+  testSinCos<float>(8192.0, 1e-7);
+  testSinCos<double>(M_PI, 3e-16);
+  testSinCos<double>(1e6, 3e-16);
+}
+
+TEST(Test_cslibs_math, testAtan2) {
+  testAtan2<float>(3e-7);
+  testAtan2<double>(5e-16);
+}
+
+TEST(Test_cslibs_math, testHypot) {
+  testHypot<float>(3e-7);
+  testHypot<double>(3e-16);
+}
+
+TEST(Test_cslibs_math, testFastAngle) {
+  namespace angle = cslibs_math::common::angle;
+  cslibs_math::random::Uniform<double, 1> rng(-100.0, 100.0, 42);
+  for (std::size_t i = 0; i < SAMPLES; ++i) {
+    const double a = rng.get();
+    const double b = rng.get();
+    EXPECT_NEAR(angle::normalize(a), angle::fast::normalize(a), 1e-12);
+    EXPECT_NEAR(angle::difference(a, b), angle::fast::difference(a, b),
+                1e-12);
+
+    const std::complex<double> c = angle::toComplex(a);
+    const std::complex<double> fast_c = angle::fast::toComplex(a);
+    EXPECT_NEAR(c.real(), fast_c.real(), 1e-15);
+    EXPECT_NEAR(c.imag(), fast_c.imag(), 1e-15);
+    EXPECT_NEAR(angle::fromComplex(c), angle::fast::fromComplex(c), 1e-15);
+  }
+  EXPECT_NEAR(-M_PI_2, angle::fast::normalize(3.0 * M_PI_2), 1e-15);
+  EXPECT_NEAR(0.1f, angle::fast::difference(0.05f, -0.05f), 1e-7f);
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
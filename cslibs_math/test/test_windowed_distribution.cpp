@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <cslibs_math/random/random.hpp>
+#include <cslibs_math/statistics/distribution.hpp>
+#include <cslibs_math/statistics/stable_distribution.hpp>
+#include <cslibs_math/statistics/windowed_distribution.hpp>
+#include <deque>
+
+const std::size_t NUM_SAMPLES = 1000;
+const std::size_t NUM_REMOVED = 600;
+const std::size_t NUM_STEPS = 50;
+const std::size_t SAMPLES_PER_STEP = 20;
+const std::size_t WINDOW = 8;
+
+template <typename distribution_t, typename samples_t>
+distribution_t build(const samples_t &samples, const std::size_t first,
+                     const std::size_t last) {
+  distribution_t d;
+  for (std::size_t i = first; i < last; ++i) d.add(samples[i]);
+  return d;
+}
+
+template <template <typename, std::size_t, std::size_t> class Distribution,
+          std::size_t Dim>
+void testRemove(const double eps) {
+  using distribution_t = Distribution<double, Dim, 0>;
+  using sample_t = Eigen::Matrix<double, Dim, 1>;
+  cslibs_math::random::Uniform<double, Dim> rng(sample_t::Constant(-10.0),
+                                                sample_t::Constant(10.0));
+  std::vector<sample_t, Eigen::aligned_allocator<sample_t>> samples;
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) samples.emplace_back(rng.get());
+
+  /// single samples
+  distribution_t d = build<distribution_t>(samples, 0, NUM_SAMPLES);
+  for (std::size_t i = 0; i < NUM_REMOVED; ++i) d.remove(samples[i]);
+  const distribution_t e =
+      build<distribution_t>(samples, NUM_REMOVED, NUM_SAMPLES);
+  EXPECT_EQ(e.getN(), d.getN());
+  EXPECT_TRUE(e.getMean().isApprox(d.getMean(), eps));
+  EXPECT_TRUE(e.getCovariance().isApprox(d.getCovariance(), eps));
+
+  /// whole distributions
+  distribution_t f = build<distribution_t>(samples, 0, NUM_SAMPLES);
+  f -= build<distribution_t>(samples, 0, NUM_REMOVED);
+  EXPECT_EQ(e.getN(), f.getN());
+  EXPECT_TRUE(e.getMean().isApprox(f.getMean(), eps));
+  EXPECT_TRUE(e.getCovariance().isApprox(f.getCovariance(), eps));
+
+  /// removing everything resets
+  f -= e;
+  EXPECT_EQ(0ul, f.getN());
+  EXPECT_FALSE(f.valid());
+  d.remove(samples.back());
+  for (std::size_t i = NUM_REMOVED; i + 1 < NUM_SAMPLES; ++i)
+    d.remove(samples[i]);
+  EXPECT_EQ(0ul, d.getN());
+}
+
+template <template <typename, std::size_t, std::size_t> class Distribution>
+void testRemove1D(const double eps) {
+  using distribution_t = Distribution<double, 1, 0>;
+  cslibs_math::random::Uniform<double, 1> rng(-10.0, 10.0);
+  std::vector<double> samples;
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) samples.emplace_back(rng.get());
+
+  distribution_t d = build<distribution_t>(samples, 0, NUM_SAMPLES);
+  for (std::size_t i = 0; i < NUM_REMOVED; ++i) d.remove(samples[i]);
+  const distribution_t e =
+      build<distribution_t>(samples, NUM_REMOVED, NUM_SAMPLES);
+  EXPECT_EQ(e.getN(), d.getN());
+  EXPECT_NEAR(e.getMean(), d.getMean(), eps);
+  EXPECT_NEAR(e.getVariance(), d.getVariance(), eps);
+
+  distribution_t f = build<distribution_t>(samples, 0, NUM_SAMPLES);
+  f -= build<distribution_t>(samples, 0, NUM_REMOVED);
+  EXPECT_EQ(e.getN(), f.getN());
+  EXPECT_NEAR(e.getMean(), f.getMean(), eps);
+  EXPECT_NEAR(e.getVariance(), f.getVariance(), eps);
+}
+
+TEST(Test_cslibs_math, testDistributionRemove) {
+  testRemove<cslibs_math::statistics::Distribution, 2>(1e-9);
+  testRemove<cslibs_math::statistics::Distribution, 3>(1e-9);
+  testRemove1D<cslibs_math::statistics::Distribution>(1e-9);
+}
+
+TEST(Test_cslibs_math, testStableDistributionRemove) {
+  testRemove<cslibs_math::statistics::StableDistribution, 2>(1e-12);
+  testRemove<cslibs_math::statistics::StableDistribution, 3>(1e-12);
+  testRemove1D<cslibs_math::statistics::StableDistribution>(1e-12);
+}
+
+TEST(Test_cslibs_math, testStableDistributionRemoveOffset) {
+  /// large offsets cancel in raw moments but not in the scatter
+  using distribution_t =
+      cslibs_math::statistics::StableDistribution<double, 2>;
+  using sample_t = distribution_t::sample_t;
+  cslibs_math::random::Uniform<double, 2> rng(sample_t::Constant(1e6 - 1.0),
+                                              sample_t::Constant(1e6 + 1.0));
+  std::vector<sample_t, Eigen::aligned_allocator<sample_t>> samples;
+  for (std::size_t i = 0; i < NUM_SAMPLES; ++i) samples.emplace_back(rng.get());
+
+  distribution_t d = build<distribution_t>(samples, 0, NUM_SAMPLES);
+  for (std::size_t i = 0; i < NUM_REMOVED; ++i) d.remove(samples[i]);
+  const distribution_t e =
+      build<distribution_t>(samples, NUM_REMOVED, NUM_SAMPLES);
+  EXPECT_TRUE(e.getCovariance().isApprox(d.getCovariance(), 1e-6));
+}
+
+template <std::size_t Dim>
+void testWindow() {
+  using windowed_t =
+      cslibs_math::statistics::WindowedDistribution<double, Dim, WINDOW>;
+  using distribution_t = typename windowed_t::distribution_t;
+  using sample_t = Eigen::Matrix<double, Dim, 1>;
+  cslibs_math::random::Uniform<double, Dim> rng(sample_t::Constant(-10.0),
+                                                sample_t::Constant(10.0));
+
+  windowed_t w;
+  std::deque<std::vector<sample_t, Eigen::aligned_allocator<sample_t>>> steps;
+  for (std::size_t s = 0; s < NUM_STEPS; ++s) {
+    if (s > 0) w.step();
+    steps.emplace_back();
+    if (steps.size() > WINDOW) steps.pop_front();
+
+    /// vary the number of samples per step, including empty steps
+    const std::size_t n = (s % 5) * SAMPLES_PER_STEP / 4;
+    for (std::size_t i = 0; i < n; ++i) {
+      steps.back().emplace_back(rng.get());
+      w.add(steps.back().back());
+    }
+
+    distribution_t e;
+    for (const auto &step : steps) {
+      for (const auto &p : step) e.add(p);
+    }
+    ASSERT_EQ(e.getN(), w.getN());
+    EXPECT_EQ(steps.back().size(), w.getStep(0).getN());
+    if (e.getN() > 0) {
+      EXPECT_TRUE(e.getMean().isApprox(w.getDistribution().getMean(), 1e-12));
+    }
+    if (e.valid()) {
+      EXPECT_TRUE(e.getCovariance().isApprox(
+          w.getDistribution().getCovariance(), 1e-9));
+    }
+  }
+
+  w.reset();
+  EXPECT_EQ(0ul, w.getN());
+  EXPECT_FALSE(w.valid());
+}
+
+TEST(Test_cslibs_math, testWindowedDistribution) {
+  testWindow<2>();
+  testWindow<3>();
+}
+
+TEST(Test_cslibs_math, testWindowedDistribution1D) {
+  cslibs_math::statistics::WindowedDistribution<double, 1, WINDOW> w;
+  cslibs_math::random::Uniform<double, 1> rng(-10.0, 10.0);
+  std::deque<std::vector<double>> steps;
+  for (std::size_t s = 0; s < NUM_STEPS; ++s) {
+    if (s > 0) w.step();
+    steps.emplace_back();
+    if (steps.size() > WINDOW) steps.pop_front();
+    for (std::size_t i = 0; i < SAMPLES_PER_STEP; ++i) {
+      steps.back().emplace_back(rng.get());
+      w += steps.back().back();
+    }
+
+    cslibs_math::statistics::StableDistribution<double, 1> e;
+    for (const auto &step : steps) {
+      for (const double p : step) e.add(p);
+    }
+    ASSERT_EQ(e.getN(), w.getN());
+    EXPECT_NEAR(e.getMean(), w.getDistribution().getMean(), 1e-12);
+    EXPECT_NEAR(e.getVariance(), w.getDistribution().getVariance(), 1e-9);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
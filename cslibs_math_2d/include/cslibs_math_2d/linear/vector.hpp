@@ -1,6 +1,7 @@
 #ifndef CSLIBS_MATH_2D_VECTOR_2D_HPP
 #define CSLIBS_MATH_2D_VECTOR_2D_HPP
 
+#include <cslibs_math/approx/trigonometric.hpp>
 #include <cslibs_math/linear/vector.hpp>
 #include <ostream>
 
@@ -15,6 +16,17 @@ inline T angle(const Vector2<T> &v)
 {
     return static_cast<T>(std::atan2(v(1), v(0)));
 }
+
+namespace fast {
+/**
+ * @brief angle with the polynomial cslibs_math::approx::atan2.
+ */
+template <typename T>
+inline T angle(const Vector2<T> &v)
+{
+    return cslibs_math::approx::atan2(v(1), v(0));
+}
+}
 }
 
 namespace std {
@@ -183,6 +183,8 @@ TEST(Test_cslibs_math_2d, testLenAngNorm)
         EXPECT_NEAR(v0.length(),  std::abs(l), 1e-5);
         EXPECT_NEAR(v0.length2(), l*l, 1e-5);
         EXPECT_NEAR(cslibs_math_2d::angle(v0), a, 1e-5);
+        EXPECT_NEAR(cslibs_math_2d::fast::angle(v0),
+                    cslibs_math_2d::angle(v0), 1e-15);
 
 
 